@@ -2,91 +2,560 @@
 
 #include "DataAsset_FontTags.h"
 
-#include "Dom/JsonObject.h"
+#include "Algo/AllOf.h"
+
+#include "Async/Async.h"
 
 #include "Engine/Font.h"
 
 #include "Fonts/SlateFontInfo.h"
 
-#include "Misc/FileHelper.h"
+#include "Framework/Notifications/NotificationManager.h"
+
+#include "HAL/FileManager.h"
+
+#include "Misc/Paths.h"
+
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+#include "UnicodeBrowser/UnicodeBrowserTagPack.h"
+#include "UnicodeBrowser/UnicodeBrowserTagTrie.h"
 
-TArray<FUnicodeCharacterTags>& UDataAsset_FontTags::GetCharactersMerged() const
+#include "UObject/ObjectSaveContext.h"
+
+#include "Widgets/Notifications/SNotificationList.h"
+
+namespace UnicodeBrowser::FontTags
 {
-	if (CharactersMerged.IsEmpty())
+	enum EVersion : int32
 	{
-		CharactersMerged = Characters;
-		// create the codepoint cache for quicker lookup of existing entries
-		CacheCodepoints();
+		Initial = 0,
+		SerializedTagData, // the snapshot of the parent chain and the bulk data of a packed preset follow the properties, each behind a flag
 
-		if (Parent && Parent != this) // there's a chance of infinite recursion here, this still doesn't catch recursion traps like A => B => A
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	FGuid const VersionGuid(0x06BCCD65, 0xBC6442C5, 0x8A743BA8, 0x443568A1);
+	FCustomVersionRegistration const RegisterVersion(VersionGuid, Latest, TEXT("UnicodeBrowserFontTags"));
+
+	// the tags in the bulk data, the arrays as they are
+	void SerializeTags(FArchive& Ar, FUnicodeCharacterTagTable& Table)
+	{
+		Ar << Table.Tags;
+		Ar << Table.Codepoints;
+		Ar << Table.TagOffsets;
+		Ar << Table.TagIds;
+	}
+
+	FUnicodeCharacterTagTable ReadTags(FMemoryView const Bytes)
+	{
+		FUnicodeCharacterTagTable Table;
+		if (!Bytes.IsEmpty())
 		{
-			for (FUnicodeCharacterTags& ParentCharacter : Parent->GetCharactersMerged())
+			FMemoryReaderView Reader(Bytes);
+			SerializeTags(Reader, Table);
+		}
+
+		return Table;
+	}
+
+	// writes the pack of a preset and deletes the packs it wrote for its previous tags, they would never be read again
+	// the name starts with the hash of the package (see GetTagPackFilename), the preset itself isn't touched
+	bool WriteTagPack(FString const& Filename, FUnicodeCharacterTagTable const& Table, uint32 const Key)
+	{
+		if (!FUnicodeBrowserTagPack::Write(Filename, Table, Key))
+			return false;
+
+		FString const Directory = FPaths::GetPath(Filename);
+		FString const CleanFilename = FPaths::GetCleanFilename(Filename);
+		FString PackageHash;
+		CleanFilename.Split(TEXT("_"), &PackageHash, nullptr);
+
+		TArray<FString> PackFilenames;
+		IFileManager::Get().FindFiles(PackFilenames, *(Directory / PackageHash + TEXT("_*.ubtp")), true, false);
+		for (FString const& PackFilename : PackFilenames)
+		{
+			if (PackFilename != CleanFilename)
 			{
-				// character exists, append tags
-				if (int32 const* CharacterIndex = CodepointLookup.Find(ParentCharacter.Character))
-				{
-					for (FString& ParentCharacterTag : ParentCharacter.Tags)
-					{
-						CharactersMerged[*CharacterIndex].Tags.AddUnique(ParentCharacterTag);
-					}
-				}
-				// character doesn't exist, add it
-				else
-				{
-					CharactersMerged.Add(ParentCharacter);
-				}
+				IFileManager::Get().Delete(*(Directory / PackFilename), false, true, true);
 			}
+		}
+
+		return true;
+	}
+}
+
+uint32 UDataAsset_FontTags::CacheSerial = 1;
+
+void FUnicodeCharacterTagTable::AddCharacter(int32 const Codepoint, TConstArrayView<FString> const CharacterTags)
+{
+	TArray<int32, TInlineAllocator<16>> CharacterTagIds;
+	for (FString const& Tag : CharacterTags)
+	{
+		if (!Tag.IsEmpty())
+		{
+			CharacterTagIds.AddUnique(FindOrAddTag(Tag));
+		}
+	}
+
+	AddCharacterIds(Codepoint, CharacterTagIds);
+}
+
+void FUnicodeCharacterTagTable::Reset()
+{
+	Tags.Reset();
+	Codepoints.Reset();
+	TagOffsets.Reset();
+	TagIds.Reset();
+	TagLookup.Reset();
+}
+
+uint32 FUnicodeCharacterTagTable::ComputeHash() const
+{
+	uint32 Hash = FCrc::MemCrc32(Codepoints.GetData(), Codepoints.Num() * Codepoints.GetTypeSize());
+	Hash = FCrc::MemCrc32(TagOffsets.GetData(), TagOffsets.Num() * TagOffsets.GetTypeSize(), Hash);
+	Hash = FCrc::MemCrc32(TagIds.GetData(), TagIds.Num() * TagIds.GetTypeSize(), Hash);
+	for (FString const& Tag : Tags)
+	{
+		Hash = FCrc::MemCrc32(*Tag, Tag.Len() * sizeof(TCHAR), Hash);
+		Hash = HashCombine(Hash, Tag.Len());
+	}
+
+	return Hash;
+}
+
+FUnicodeCharacterTagTable FUnicodeCharacterTagTable::MergeWithParent(FUnicodeCharacterTagTable const& Parent) const
+{
+	FUnicodeCharacterTagTable Merged;
+	Merged.Tags = Tags; // the own tag ids stay valid
+	Merged.Codepoints.Reserve(Num() + Parent.Num());
+	Merged.TagOffsets.Reserve(Num() + Parent.Num() + 1);
+	Merged.TagIds.Reserve(TagIds.Num() + Parent.TagIds.Num());
+
+	// every tag of the parent is looked up once, the characters only remap ids
+	TArray<int32> ParentTagIds;
+	ParentTagIds.Reserve(Parent.NumTags());
+	for (FString const& Tag : Parent.Tags)
+	{
+		ParentTagIds.Add(Merged.FindOrAddTag(Tag));
+	}
 
-			// recreate the codepoint cache if the parent has any characters
-			if (Parent->GetCharactersMerged().Num() > 0)
+	TMap<int32, int32> ParentLookup;
+	ParentLookup.Reserve(Parent.Num());
+	for (int32 Character = 0; Character < Parent.Num(); ++Character)
+	{
+		ParentLookup.Add(Parent.Codepoints[Character], Character);
+	}
+
+	// the last character which got a tag, this keeps the tags of a character unique without searching them
+	TArray<int32> TagCharacters;
+	TagCharacters.Init(INDEX_NONE, Merged.NumTags());
+
+	TBitArray<> ParentMerged(false, Parent.Num());
+	TArray<int32, TInlineAllocator<16>> CharacterTagIds;
+	for (int32 Character = 0; Character < Num(); ++Character)
+	{
+		CharacterTagIds = GetTagIds(Character);
+		for (int32 const TagId : CharacterTagIds)
+		{
+			TagCharacters[TagId] = Character;
+		}
+
+		// character exists in the parent, append its tags
+		if (int32 const* ParentCharacter = ParentLookup.Find(Codepoints[Character]); ParentCharacter && !ParentMerged[*ParentCharacter])
+		{
+			ParentMerged[*ParentCharacter] = true;
+			for (int32 const ParentTagId : Parent.GetTagIds(*ParentCharacter))
 			{
-				CacheCodepoints();
+				int32 const TagId = ParentTagIds[ParentTagId];
+				if (TagCharacters[TagId] != Character)
+				{
+					TagCharacters[TagId] = Character;
+					CharacterTagIds.Add(TagId);
+				}
 			}
 		}
+
+		Merged.AddCharacterIds(Codepoints[Character], CharacterTagIds);
 	}
-	return CharactersMerged;
+
+	// characters which only the parent has
+	for (int32 Character = 0; Character < Parent.Num(); ++Character)
+	{
+		if (ParentMerged[Character])
+			continue;
+
+		CharacterTagIds.Reset();
+		for (int32 const ParentTagId : Parent.GetTagIds(Character))
+		{
+			CharacterTagIds.Add(ParentTagIds[ParentTagId]);
+		}
+
+		Merged.AddCharacterIds(Parent.Codepoints[Character], CharacterTagIds);
+	}
+
+	return Merged;
 }
 
-TArray<int32> UDataAsset_FontTags::GetCharactersByNeedle(FString NeedleIn) const
+FUnicodeCharacterTagDelta FUnicodeCharacterTagTable::Diff(FUnicodeCharacterTagTable const& Other) const
 {
-	TArray<int32> Result;
-	TArray<FString> Needles;
+	FUnicodeCharacterTagDelta Delta;
 
-	// explode only if the length is >1 since "," is a valid character search term
-	if (NeedleIn.Len() > 1)
+	// every codepoint is listed once in both tables, the readers merge the tags of characters which a file lists more than once
+	TMap<int32, int32> Lookup;
+	Lookup.Reserve(Num());
+	for (int32 Character = 0; Character < Num(); ++Character)
 	{
-		NeedleIn.ParseIntoArray(Needles, TEXT(","));
+		int32 const& Found = Lookup.FindOrAdd(Codepoints[Character], Character);
+		check(Found == Character);
 	}
-	else
+
+	TBitArray<> Kept(false, Num());
+	for (int32 OtherCharacter = 0; OtherCharacter < Other.Num(); ++OtherCharacter)
 	{
-		Needles = {NeedleIn};
+		int32 const* Character = Lookup.Find(Other.Codepoints[OtherCharacter]);
+		if (!Character)
+		{
+			Delta.Upserts.AddCharacterFrom(Other, OtherCharacter);
+			++Delta.NumAdded;
+			continue;
+		}
+
+		check(!Kept[*Character]);
+		Kept[*Character] = true;
+
+		TConstArrayView<int32> const OwnIds = GetTagIds(*Character);
+		TConstArrayView<int32> const OtherIds = Other.GetTagIds(OtherCharacter);
+		bool bChanged = OwnIds.Num() != OtherIds.Num();
+		// compared like the tag lookup interns them, a change which the lookup would drop would show up in every diff
+		for (int32 Tag = 0; !bChanged && Tag < OwnIds.Num(); ++Tag)
+		{
+			bChanged = !FUnicodeCharacterTagKeyFuncs::Matches(Tags[OwnIds[Tag]], Other.Tags[OtherIds[Tag]]);
+		}
+
+		if (bChanged)
+		{
+			Delta.Upserts.AddCharacterFrom(Other, OtherCharacter);
+		}
 	}
 
-	// trim, as the user may type stuff like "Phone, Calculator"
-	for (FString& Needle : Needles)
+	for (int32 Character = 0; Character < Num(); ++Character)
 	{
-		Needle.TrimStartAndEndInline();
+		if (!Kept[Character])
+		{
+			Delta.Removed.Add(Codepoints[Character]);
+		}
+	}
+
+	return Delta;
+}
+
+void FUnicodeCharacterTagTable::ApplyDelta(FUnicodeCharacterTagDelta const& Delta)
+{
+	if (Delta.IsEmpty())
+		return;
+
+	// every tag of the delta is looked up once, the characters only remap ids
+	TArray<int32> UpsertTagIds;
+	UpsertTagIds.Reserve(Delta.Upserts.NumTags());
+	for (FString const& Tag : Delta.Upserts.Tags)
+	{
+		UpsertTagIds.Add(FindOrAddTag(Tag));
+	}
+
+	TMap<int32, int32> Upserts;
+	Upserts.Reserve(Delta.Upserts.Num());
+	for (int32 Character = 0; Character < Delta.Upserts.Num(); ++Character)
+	{
+		Upserts.Add(Delta.Upserts.Codepoints[Character], Character);
+	}
+
+	TSet<int32> const Removed(Delta.Removed);
+	TBitArray<> Applied(false, Delta.Upserts.Num());
+
+	TArray<int32> OldCodepoints = MoveTemp(Codepoints);
+	TArray<int32> OldTagOffsets = MoveTemp(TagOffsets);
+	TArray<int32> OldTagIds = MoveTemp(TagIds);
+	Codepoints.Reset(OldCodepoints.Num() + Delta.NumAdded);
+	TagOffsets.Reset(OldCodepoints.Num() + Delta.NumAdded + 1);
+	TagIds.Reset(OldTagIds.Num());
+
+	TArray<int32, TInlineAllocator<16>> CharacterTagIds;
+	auto AddUpsert = [&](int32 const Upsert)
+	{
+		CharacterTagIds.Reset();
+		for (int32 const UpsertTagId : Delta.Upserts.GetTagIds(Upsert))
+		{
+			CharacterTagIds.AddUnique(UpsertTagIds[UpsertTagId]);
+		}
+
+		AddCharacterIds(Delta.Upserts.Codepoints[Upsert], CharacterTagIds);
+		Applied[Upsert] = true;
+	};
+
+	// the characters keep their order, so unchanged parts of the table stay the same
+	for (int32 Character = 0; Character < OldCodepoints.Num(); ++Character)
+	{
+		int32 const Codepoint = OldCodepoints[Character];
+		if (Removed.Contains(Codepoint))
+			continue;
+
+		if (int32 const* Upsert = Upserts.Find(Codepoint))
+		{
+			AddUpsert(*Upsert);
+		}
+		else
+		{
+			AddCharacterIds(Codepoint, MakeArrayView(OldTagIds).Mid(OldTagOffsets[Character], OldTagOffsets[Character + 1] - OldTagOffsets[Character]));
+		}
+	}
+
+	for (int32 Upsert = 0; Upsert < Delta.Upserts.Num(); ++Upsert)
+	{
+		if (!Applied[Upsert])
+		{
+			AddUpsert(Upsert);
+		}
+	}
+}
+
+void FUnicodeCharacterTagTable::CompactTags()
+{
+	TBitArray<> Used(false, NumTags());
+	for (int32 const TagId : TagIds)
+	{
+		Used[TagId] = true;
+	}
+
+	int32 const NumUnused = NumTags() - Used.CountSetBits();
+	if (NumUnused == 0 || NumUnused * 4 < NumTags())
+		return;
+
+	TArray<int32> NewTagIds;
+	NewTagIds.Init(INDEX_NONE, NumTags());
+	TArray<FString> UsedTags;
+	UsedTags.Reserve(NumTags() - NumUnused);
+	for (TConstSetBitIterator<> It(Used); It; ++It)
+	{
+		NewTagIds[It.GetIndex()] = UsedTags.Add(MoveTemp(Tags[It.GetIndex()]));
+	}
+
+	Tags = MoveTemp(UsedTags);
+	for (int32& TagId : TagIds)
+	{
+		TagId = NewTagIds[TagId];
 	}
 
-	Result.Reserve(GetCharactersMerged().Num());
-	for (FUnicodeCharacterTags const& Entry : GetCharactersMerged())
+	TagLookup.Reset();
+}
+
+SIZE_T FUnicodeCharacterTagTable::GetAllocatedSize() const
+{
+	SIZE_T Size = Tags.GetAllocatedSize() + Codepoints.GetAllocatedSize() + TagOffsets.GetAllocatedSize() + TagIds.GetAllocatedSize() + TagLookup.GetAllocatedSize();
+	for (FString const& Tag : Tags)
+	{
+		Size += Tag.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+int32 FUnicodeCharacterTagTable::FindOrAddTag(FString const& Tag)
+{
+	// the lookup isn't serialized
+	if (TagLookup.Num() != Tags.Num())
 	{
-		for (FString const& Needle : Needles)
+		TagLookup.Reset();
+		TagLookup.Reserve(Tags.Num());
+		for (int32 TagId = 0; TagId < Tags.Num(); ++TagId)
 		{
-			if (Entry.ContainsNeedle(Needle))
+			TagLookup.Add(Tags[TagId], TagId);
+		}
+	}
+
+	if (int32 const* TagId = TagLookup.Find(Tag))
+	{
+		return *TagId;
+	}
+
+	int32 const TagId = Tags.Add(Tag);
+	TagLookup.Add(Tag, TagId);
+	return TagId;
+}
+
+void FUnicodeCharacterTagTable::AddCharacterFrom(FUnicodeCharacterTagTable const& Source, int32 const Character)
+{
+	TArray<int32, TInlineAllocator<16>> CharacterTagIds;
+	for (int32 const SourceTagId : Source.GetTagIds(Character))
+	{
+		CharacterTagIds.AddUnique(FindOrAddTag(Source.Tags[SourceTagId]));
+	}
+
+	AddCharacterIds(Source.Codepoints[Character], CharacterTagIds);
+}
+
+void FUnicodeCharacterTagTable::AddCharacterIds(int32 const Codepoint, TConstArrayView<int32> const CharacterTagIds)
+{
+	if (TagOffsets.IsEmpty())
+	{
+		TagOffsets.Add(0);
+	}
+
+	Codepoints.Add(Codepoint);
+	TagIds.Append(CharacterTagIds);
+	TagOffsets.Add(TagIds.Num());
+}
+
+FUnicodeCharacterTagTable const& UDataAsset_FontTags::GetMergedTags() const
+{
+	if (CachedSerial != CacheSerial)
+	{
+		// mark the cache as valid up front, a parent which references this asset then gets the partial data instead of recursing
+		CachedSerial = CacheSerial;
+
+		uint32 const CompileKey = GetCompileKey();
+		if (CompileKey != MergedKey)
+		{
+			MergedKey = CompileKey;
+			TagIndex.Reset();
+			PatchedTagIndex.Reset();
+			TagTrie.Reset();
+
+			if (Parent && !Parent->IsInParentChain(this))
 			{
-				Result.Add(Entry.Character);
-				break;
+				MergedTags = bTagsInPack ? ReadOwnTags().MergeWithParent(Parent->GetMergedTags()) : TagTable.MergeWithParent(Parent->GetMergedTags());
 			}
+			else
+			{
+				UE_CLOG(Parent != nullptr, LogTemp, Warning, TEXT("[UDataAsset_FontTags::GetMergedTags] %s is its own ancestor, the tags of its parents are ignored"), *GetPathName());
+				MergedTags = bTagsInPack ? ReadOwnTags() : TagTable;
+			}
+
+			CodepointLookup.Reset();
 		}
 	}
 
+	// the lookup isn't serialized with the merged tags
+	if (CodepointLookup.IsEmpty() && MergedTags.Num() > 0)
+	{
+		CacheCodepoints();
+	}
+
+	return MergedTags;
+}
+
+bool UDataAsset_FontTags::IsInParentChain(UDataAsset_FontTags const* Asset) const
+{
+	TSet<UDataAsset_FontTags const*, DefaultKeyFuncs<UDataAsset_FontTags const*>, TInlineSetAllocator<8>> Visited;
+	for (UDataAsset_FontTags const* Ancestor = this; Ancestor && !Visited.Contains(Ancestor); Ancestor = Ancestor->Parent)
+	{
+		if (Ancestor == Asset)
+			return true;
+
+		Visited.Add(Ancestor);
+	}
+
+	return false;
+}
+
+uint32 UDataAsset_FontTags::GetCompileKey() const
+{
+	// the chain ends at the first asset which was visited already
+	uint32 Key = TagTableHash;
+	TSet<UDataAsset_FontTags const*, DefaultKeyFuncs<UDataAsset_FontTags const*>, TInlineSetAllocator<8>> Visited = {this};
+	for (UDataAsset_FontTags const* Ancestor = Parent; Ancestor && !Visited.Contains(Ancestor); Ancestor = Ancestor->Parent)
+	{
+		Key = HashCombine(Key, Ancestor->TagTableHash);
+		Visited.Add(Ancestor);
+	}
+
+	return Key;
+}
+
+TSharedRef<FUnicodeBrowserTagIndex const> UDataAsset_FontTags::GetTagIndex() const
+{
+	// the pack stores the index, nothing gets loaded until a query touches it
+	if (IsServedFromPack())
+	{
+		if (!TagIndex.IsValid())
+		{
+			TagIndex = MakeShared<FUnicodeBrowserTagIndex>(GetTagPack().ToSharedRef());
+		}
+
+		return TagIndex.ToSharedRef();
+	}
+
+	// ReSharper disable once CppExpressionWithoutSideEffects
+	GetMergedTags(); // resets the index if the merged data is outdated
+
+	if (!TagIndex.IsValid())
+	{
+		TagIndex = PatchedTagIndex.IsValid() ? MakeShared<FUnicodeBrowserTagIndex>(*PatchedTagIndex, MergedTags) : MakeShared<FUnicodeBrowserTagIndex>(MergedTags);
+		PatchedTagIndex.Reset();
+	}
+
+	return TagIndex.ToSharedRef();
+}
+
+TSharedRef<FUnicodeBrowserTagTrie const> UDataAsset_FontTags::GetTagTrie() const
+{
+	// the index resets the trie if the merged data is outdated
+	TSharedRef<FUnicodeBrowserTagIndex const> const Index = GetTagIndex();
+
+	if (!TagTrie.IsValid())
+	{
+		TagTrie = MakeShared<FUnicodeBrowserTagTrie>(*Index);
+	}
+
+	return TagTrie.ToSharedRef();
+}
+
+FUnicodeBrowserCodepointSet UDataAsset_FontTags::GetCharactersByNeedle(FString NeedleIn) const
+{
+	FUnicodeBrowserCodepointSet Result;
+	TArray<FString> Needles;
+	ParseNeedles(NeedleIn, Needles);
+
+	TSharedRef<FUnicodeBrowserTagIndex const> const Index = GetTagIndex();
+
+	// the set takes care of entries which match multiple needles
+	TArray<int32> Entries;
+	for (FString const& Needle : Needles)
+	{
+		Index->FindEntries(Needle, Entries);
+	}
+
+	for (int32 const Entry : Entries)
+	{
+		Result.Add(Index->GetCodepoint(Entry));
+	}
+
 	return Result;
 }
 
+void UDataAsset_FontTags::ParseNeedles(FString const& NeedleIn, TArray<FString>& OutNeedles)
+{
+	// explode only if the length is >1 since "," is a valid character search term
+	if (NeedleIn.Len() > 1)
+	{
+		NeedleIn.ParseIntoArray(OutNeedles, TEXT(","));
+	}
+	else
+	{
+		OutNeedles = {NeedleIn};
+	}
+
+	// trim, as the user may type stuff like "Phone, Calculator"
+	for (FString& Needle : OutNeedles)
+	{
+		Needle.TrimStartAndEndInline();
+	}
+}
+
 bool UDataAsset_FontTags::SupportsFont(FSlateFontInfo const& FontInfo) const
 {
 	// allow presets to apply to all fonts if they don't contain any specific fonts
@@ -96,115 +565,515 @@ bool UDataAsset_FontTags::SupportsFont(FSlateFontInfo const& FontInfo) const
 void UDataAsset_FontTags::CacheCodepoints() const
 {
 	CodepointLookup.Reset();
-	CodepointLookup.Reserve(CharactersMerged.Num());
+	CodepointLookup.Reserve(MergedTags.Num());
 
-	for (int Idx = 0; Idx < CharactersMerged.Num(); Idx++)
+	for (int Idx = 0; Idx < MergedTags.Num(); Idx++)
 	{
-		CodepointLookup.Add(CharactersMerged[Idx].Character, Idx);
+		CodepointLookup.Add(MergedTags.Codepoints[Idx], Idx);
 	}
 }
 
 TArray<FString> UDataAsset_FontTags::GetCodepointTags(int32 const Codepoint) const
 {
-	if (CodepointLookup.IsEmpty())
+	if (IsServedFromPack())
 	{
-		// this creates the cache
-		// ReSharper disable once CppExpressionWithoutSideEffects
-		GetCharactersMerged();
+		TSharedPtr<FUnicodeBrowserTagPack const> const Pack = GetTagPack();
+		FUnicodeBrowserTagIndex::FView const& View = Pack->GetIndexView();
+
+		TArray<FString> Tags;
+		int32 const Entry = Pack->FindEntry(Codepoint);
+		if (Entry != INDEX_NONE)
+		{
+			for (int32 const TagId : View.GetEntryTagIds(Entry))
+			{
+				if (View.IsValidTag(TagId))
+				{
+					Tags.Emplace(Pack->GetTag(TagId));
+				}
+			}
+		}
+
+		return Tags;
 	}
 
+	// this creates the cache if it's outdated
+	FUnicodeCharacterTagTable const& Merged = GetMergedTags();
+
+	TArray<FString> Tags;
 	if (int32 const* Index = CodepointLookup.Find(Codepoint))
 	{
-		return GetCharactersMerged()[*Index].Tags;
+		for (int32 const TagId : Merged.GetTagIds(*Index))
+		{
+			Tags.Add(Merged.Tags[TagId]);
+		}
 	}
 
-	return {};
+	return Tags;
 }
 
-bool UDataAsset_FontTags::ImportFromJson(FString Filename)
+void UDataAsset_FontTags::ApplyImport(FString const& Filename, FUnicodeCharacterTagTable&& Table)
 {
-	FString JsonString = "";
+	// the delta needs the current tags
+	MaterializePackedTags();
 
-	if (!FFileHelper::LoadFileToString(JsonString, *Filename)) return false;
+	FUnicodeCharacterTagDelta const Delta = TagTable.Diff(Table);
+	if (Delta.IsEmpty() && SourceFile == Filename)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[UDataAsset_FontTags::ApplyImport] %s: no tags changed"), *GetPathName());
+		return;
+	}
 
+	Modify();
 	SourceFile = Filename;
+	if (Delta.IsEmpty())
+		return;
 
-	FString CodePointFieldDecimal = "";
-	FString CodePointFieldHexadecimal = "";
-	TArray<FString> TagFields;
-
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	auto const Reader = TJsonReaderFactory<>::Create(JsonString);
-	FJsonSerializer::Deserialize(Reader, JsonObject);
-
-	if (!JsonObject->HasTypedField<EJson::Array>(TEXT("tagFields")))
-		return false;
-
-	if(JsonObject->HasTypedField<EJson::String>(TEXT("codepointFieldDecimal")))
-		JsonObject->TryGetStringField(TEXT("codepointFieldDecimal"), CodePointFieldDecimal);
-	
-	if(JsonObject->HasTypedField<EJson::String>(TEXT("codepointFieldHexadecimal")))
-		JsonObject->TryGetStringField(TEXT("codepointFieldHexadecimal"), CodePointFieldHexadecimal);
+	// the merged tags can only be patched if they match the tags before the changes
+	bool const bPatchMergedTags = MergedKey == GetCompileKey() && MergedKey != 0;
 
-	if (CodePointFieldDecimal.IsEmpty() && CodePointFieldHexadecimal.IsEmpty())
-		return false;
+	TagTable.ApplyDelta(Delta);
+	TagTable.CompactTags();
+	TagTableHash = TagTable.ComputeHash();
 
-	JsonObject->TryGetStringArrayField(TEXT("tagFields"), TagFields);
-	if (TagFields.IsEmpty())
-		return false;
+	if (bPatchMergedTags)
+	{
+		PatchMergedTags(Delta);
+	}
 
-	if (!JsonObject->HasTypedField<EJson::Array>(TEXT("glyphs")))
-		return false;
+	UE_LOG(
+		LogTemp,
+		Log,
+		TEXT("[UDataAsset_FontTags::ApplyImport] %s: %d characters added, %d changed, %d removed"),
+		*GetPathName(),
+		Delta.NumAdded,
+		Delta.Upserts.Num() - Delta.NumAdded,
+		Delta.Removed.Num()
+	);
 
-	TArray<TSharedPtr<FJsonValue>> Glyphs = JsonObject->GetArrayField(TEXT("glyphs"));
-	if (Glyphs.IsEmpty())
-		return false;
+	// assets which have this one as ancestor need to compile their tags again
+	InvalidateCaches();
+}
 
-	// flush current entries (e.g. on reimport there might be existing data)
-	Characters.Empty();
-	
-	for (TSharedPtr<FJsonValue> const& GlyphValue : Glyphs)
+void UDataAsset_FontTags::PatchMergedTags(FUnicodeCharacterTagDelta const& Delta) const
+{
+	UDataAsset_FontTags const* MergeParent = Parent && !Parent->IsInParentChain(this) ? Parent.Get() : nullptr;
+	if (!MergeParent)
+	{
+		MergedTags.ApplyDelta(Delta);
+	}
+	else
 	{
-		TSharedPtr<FJsonObject> const Glyph = GlyphValue->AsObject();
-		FUnicodeCharacterTags Data;
+		// a changed character gets the tags of the parent appended, like MergeWithParent does,
+		// a character which isn't an own character anymore falls back to the tags of the parent
+		FUnicodeCharacterTagTable const& ParentTags = MergeParent->GetMergedTags();
+		FUnicodeCharacterTagDelta MergedDelta;
+		TArray<FString> CharacterTags;
 
-		if (CodePointFieldDecimal.Len() > 0)
+		auto AddParentTags = [&](int32 const Codepoint)
 		{
-			if (Glyph->HasTypedField<EJson::Number>(*CodePointFieldDecimal))
+			if (int32 const* ParentCharacter = MergeParent->CodepointLookup.Find(Codepoint))
 			{
-				Data.Character = Glyph->GetNumberField(*CodePointFieldDecimal);
+				for (int32 const TagId : ParentTags.GetTagIds(*ParentCharacter))
+				{
+					CharacterTags.Add(ParentTags.Tags[TagId]);
+				}
 			}
-			else if (Glyph->HasTypedField<EJson::String>(*CodePointFieldDecimal))
+		};
+
+		for (int32 Character = 0; Character < Delta.Upserts.Num(); ++Character)
+		{
+			CharacterTags.Reset();
+			for (int32 const TagId : Delta.Upserts.GetTagIds(Character))
 			{
-				FString DecimalString = Glyph->GetStringField(*CodePointFieldDecimal);
-				Data.Character = FCString::Strtoi(*DecimalString, nullptr, 10);
+				CharacterTags.Add(Delta.Upserts.Tags[TagId]);
 			}
+
+			AddParentTags(Delta.Upserts.Codepoints[Character]);
+			MergedDelta.Upserts.AddCharacter(Delta.Upserts.Codepoints[Character], CharacterTags);
 		}
-		else if (CodePointFieldHexadecimal.Len() > 0)
+
+		for (int32 const Codepoint : Delta.Removed)
 		{
-			if (!Glyph->HasTypedField<EJson::String>(*CodePointFieldHexadecimal))
+			if (!MergeParent->CodepointLookup.Contains(Codepoint))
+			{
+				MergedDelta.Removed.Add(Codepoint);
 				continue;
+			}
 
-			FString HexString = Glyph->GetStringField(*CodePointFieldHexadecimal);
-			if (!HexString.StartsWith("0x", ESearchCase::IgnoreCase))
-				continue;
+			CharacterTags.Reset();
+			AddParentTags(Codepoint);
+			MergedDelta.Upserts.AddCharacter(Codepoint, CharacterTags);
+		}
+
+		MergedTags.ApplyDelta(MergedDelta);
+	}
+
+	MergedKey = GetCompileKey();
+	CodepointLookup.Reset();
+
+	// the patched table only got tags appended, so the next index can start from the current one
+	if (TagIndex.IsValid())
+	{
+		PatchedTagIndex = TagIndex;
+	}
+
+	TagIndex.Reset();
+	TagTrie.Reset();
+}
+
+FUnicodeCharacterTagTable UDataAsset_FontTags::ReadOwnTags() const
+{
+	TSharedPtr<FUnicodeBrowserTagPack const> const Pack = GetTagPack();
+	FUnicodeCharacterTagTable Table;
+	if (Pack.IsValid() && Pack->ToTable(Table))
+		return Table;
+
+	UE_CLOG(Pack.IsValid(), LogTemp, Warning, TEXT("[UDataAsset_FontTags::ReadOwnTags] %s: the tag pack %s is damaged, the tags are read from the package"), *GetPathName(), *GetTagPackFilename());
+	return ReadPackedTags();
+}
 
-			Data.Character = FCString::Strtoi(*HexString, nullptr, 16);
+FUnicodeCharacterTagTable UDataAsset_FontTags::ReadPackedTags() const
+{
+	if (PackedTags.GetBulkDataSize() == 0)
+		return FUnicodeCharacterTagTable();
+
+	FUnicodeCharacterTagTable Table = UnicodeBrowser::FontTags::ReadTags(FMemoryView(PackedTags.LockReadOnly(), PackedTags.GetBulkDataSize()));
+	PackedTags.Unlock();
+	return Table;
+}
+
+void UDataAsset_FontTags::MaterializePackedTags()
+{
+	if (!bTagsInPack)
+		return;
+
+	TagTable = ReadOwnTags();
+	PackedTagsKey = TagTableHash; // the bulk data stays up to date until the tags change
+	TagPack.Reset();
+	bTagsInPack = false;
+
+	// merged tags which were compiled from the pack stay valid, any other ones get compiled from TagTable
+	CachedSerial = 0;
+	UE_LOG(LogTemp, Log, TEXT("[UDataAsset_FontTags::MaterializePackedTags] %s: read %d characters"), *GetPathName(), TagTable.Num());
+}
+
+bool UDataAsset_FontTags::IsServedFromPack() const
+{
+	return bTagsInPack && !Parent && GetTagPack().IsValid();
+}
+
+void UDataAsset_FontTags::LoadEditedCharacter()
+{
+	// editing works on TagTable, the tags of a packed preset are read back first
+	MaterializePackedTags();
+
+	EditedCharacter.Tags.Reset();
+	int32 const Character = TagTable.Codepoints.Find(EditedCharacter.Character);
+	if (Character != INDEX_NONE)
+	{
+		for (int32 const TagId : TagTable.GetTagIds(Character))
+		{
+			EditedCharacter.Tags.Add(TagTable.Tags[TagId]);
 		}
+	}
+}
+
+void UDataAsset_FontTags::ApplyEditedCharacter()
+{
+	MaterializePackedTags();
 
-		for (FString& TagField : TagFields)
+	bool const bExists = TagTable.Codepoints.Contains(EditedCharacter.Character);
+
+	FUnicodeCharacterTagDelta Delta;
+	if (Algo::AllOf(EditedCharacter.Tags, [](FString const& Tag) { return Tag.IsEmpty(); }))
+	{
+		if (bExists)
 		{
-			FString Tag = "";
-			Glyph->TryGetStringField(*TagField, Tag);
+			Delta.Removed.Add(EditedCharacter.Character);
+		}
+	}
+	else
+	{
+		Delta.Upserts.AddCharacter(EditedCharacter.Character, EditedCharacter.Tags);
+		Delta.NumAdded = bExists ? 0 : 1;
+	}
+
+	if (Delta.IsEmpty())
+		return;
+
+	// the merged tags can only be patched if they match the tags before the changes
+	bool const bPatchMergedTags = MergedKey == GetCompileKey() && MergedKey != 0;
+
+	TagTable.ApplyDelta(Delta);
+	TagTable.CompactTags();
+	TagTableHash = TagTable.ComputeHash();
 
-			if (Tag.Len() > 0)
+	if (bPatchMergedTags)
+	{
+		PatchMergedTags(Delta);
+	}
+}
+
+TSharedPtr<FUnicodeBrowserTagPack const> UDataAsset_FontTags::GetTagPack() const
+{
+	if (bTagsInPack && !TagPack.IsValid() && !bTagPackMissing && !bTagPackBuilding)
+	{
+		// the pack only caches the bulk data, a missing or outdated one is built again
+		TagPack = FUnicodeBrowserTagPack::Open(GetTagPackFilename(), TagTableHash);
+		if (!TagPack.IsValid())
+		{
+			BuildTagPack();
+		}
+	}
+
+	return TagPack;
+}
+
+void UDataAsset_FontTags::BuildTagPack() const
+{
+	// only the bytes of the bulk data are copied here, reading the tags and indexing them for the pack runs on a worker thread
+	TArray64<uint8> Bytes;
+	if (PackedTags.GetBulkDataSize() > 0)
+	{
+		Bytes.Append(static_cast<uint8 const*>(PackedTags.LockReadOnly()), PackedTags.GetBulkDataSize());
+		PackedTags.Unlock();
+	}
+
+	bTagPackBuilding = true;
+	Async(
+		EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakObjectPtr<UDataAsset_FontTags const>(this), Filename = GetTagPackFilename(), Key = TagTableHash, Bytes = MoveTemp(Bytes)]()
+		{
+			bool const bWritten = UnicodeBrowser::FontTags::WriteTagPack(Filename, UnicodeBrowser::FontTags::ReadTags(MakeMemoryView(Bytes)), Key);
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[WeakThis, Key, bWritten]()
+				{
+					if (UDataAsset_FontTags const* Asset = WeakThis.Get())
+					{
+						Asset->OnTagPackBuilt(Key, bWritten);
+					}
+				}
+			);
+		}
+	);
+}
+
+void UDataAsset_FontTags::OnTagPackBuilt(uint32 const Key, bool const bWritten) const
+{
+	bTagPackBuilding = false;
+
+	// the asset was loaded again or its tags were materialized in the meantime, the next query starts over
+	if (!bTagsInPack || Key != TagTableHash)
+		return;
+
+	FString const Filename = GetTagPackFilename();
+	TagPack = bWritten ? FUnicodeBrowserTagPack::Open(Filename, TagTableHash) : nullptr;
+	UE_CLOG(!TagPack.IsValid(), LogTemp, Log, TEXT("[UDataAsset_FontTags::OnTagPackBuilt] %s: can't build the tag pack %s, the tags are read from the package"), *GetPathName(), *Filename);
+
+	bTagPackMissing = !TagPack.IsValid();
+	if (TagPack.IsValid() && !Parent)
+	{
+		// the queries switch over to the pack, the tags which were read from the bulk data in the meantime are released
+		// a preset which uses this one as parent compiles its merged tags from the pack instead
+		MergedTags = FUnicodeCharacterTagTable();
+		MergedKey = 0;
+		CachedSerial = 0;
+		CodepointLookup.Empty();
+		TagIndex.Reset();
+		PatchedTagIndex.Reset();
+		TagTrie.Reset();
+	}
+}
+
+FString UDataAsset_FontTags::GetTagPackFilename() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("UnicodeBrowser") / FString::Printf(TEXT("%08X_%08X.ubtp"), FCrc::StrCrc32(*GetPackage()->GetName()), TagTableHash);
+}
+
+void UDataAsset_FontTags::InvalidateCaches()
+{
+	++CacheSerial;
+}
+
+void UDataAsset_FontTags::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(UnicodeBrowser::FontTags::VersionGuid);
+
+	// the tags of a preset with up to date bulk data (see PreSave) are only saved as bulk data, undo keeps them
+	bool const bSavePacked = Ar.IsSaving() && Ar.IsPersistent() && !Ar.IsTransacting() && bUseTagPack && (bTagsInPack || PackedTagsKey == TagTableHash);
+	FUnicodeCharacterTagTable OwnTags;
+	if (bSavePacked)
+	{
+		OwnTags = MoveTemp(TagTable);
+	}
+
+	Super::Serialize(Ar);
+
+	if (bSavePacked)
+	{
+		TagTable = MoveTemp(OwnTags);
+	}
+
+	if (Ar.IsLoading() && Ar.CustomVer(UnicodeBrowser::FontTags::VersionGuid) < UnicodeBrowser::FontTags::SerializedTagData)
+		return;
+
+	// saving compiles the snapshot first (see PreSave), a loaded snapshot is used as long as its key matches the chain
+	// a preset without parent would save its tags twice and a packed preset has no snapshot, it would be as large as the tags
+	// only packages get one, other archives like undo and duplication leave it to be compiled again
+	bool bHasSnapshot = Ar.IsSaving() && Ar.IsPersistent() && !Ar.IsTransacting() && Parent && !bSavePacked;
+	Ar << bHasSnapshot;
+	if (bHasSnapshot)
+	{
+		FUnicodeCharacterTagTable::StaticStruct()->SerializeItem(Ar, &MergedTags, nullptr);
+		Ar << MergedKey;
+	}
+
+	bool bPacked = bSavePacked || bTagsInPack;
+	Ar << bPacked;
+	if (bPacked)
+	{
+		PackedTags.Serialize(Ar, this);
+	}
+
+	if (Ar.IsLoading())
+	{
+		bTagsInPack = bPacked;
+		PackedTagsKey = bPacked ? TagTableHash : 0;
+		TagPack.Reset();
+		bTagPackMissing = false;
+	}
+}
+
+void UDataAsset_FontTags::PreSave(FObjectPreSaveContext const SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// the bulk data of a preset which was loaded packed is up to date, the tags only change after they were materialized
+	if (bUseTagPack && !bTagsInPack && PackedTagsKey != TagTableHash)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		UnicodeBrowser::FontTags::SerializeTags(Writer, TagTable);
+
+		PackedTags.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+		PackedTags.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(PackedTags.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+		PackedTags.Unlock();
+		PackedTagsKey = TagTableHash;
+	}
+
+	// only a preset with a parent which isn't packed saves a snapshot (see Serialize)
+	if (Parent && (!bUseTagPack || (!bTagsInPack && PackedTagsKey != TagTableHash)))
+	{
+		// ReSharper disable once CppExpressionWithoutSideEffects
+		GetMergedTags();
+	}
+}
+
+void UDataAsset_FontTags::PostLoad()
+{
+	Super::PostLoad();
+
+	if (!Characters_DEPRECATED.IsEmpty())
+	{
+		// the old arrays could list a character more than once, the table keeps every codepoint once (see Diff)
+		TMap<int32, int32> CharacterIndices;
+		TArray<TArray<FString>> CharacterTags;
+		TArray<int32> Codepoints;
+		for (FUnicodeCharacterTags const& Character : Characters_DEPRECATED)
+		{
+			int32 const Index = CharacterIndices.FindOrAdd(Character.Character, Codepoints.Num());
+			if (Index == Codepoints.Num())
 			{
-				Data.Tags.Add(Tag);
+				Codepoints.Add(Character.Character);
+				CharacterTags.AddDefaulted();
 			}
+
+			CharacterTags[Index].Append(Character.Tags);
 		}
 
-		Characters.Add(Data);
+		TagTable.Reset();
+		for (int32 Index = 0; Index < Codepoints.Num(); ++Index)
+		{
+			TagTable.AddCharacter(Codepoints[Index], CharacterTags[Index]);
+		}
+
+		Characters_DEPRECATED.Empty();
 	}
 
-	return true;
+	// assets from before the snapshot have no hash yet
+	if (GetLinkerCustomVersion(UnicodeBrowser::FontTags::VersionGuid) < UnicodeBrowser::FontTags::SerializedTagData)
+	{
+		TagTableHash = TagTable.ComputeHash();
+		InvalidateCaches();
+	}
+}
+
+void UDataAsset_FontTags::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	if (PropertyAboutToChange && PropertyAboutToChange->GetFName() == GET_MEMBER_NAME_CHECKED(UDataAsset_FontTags, Parent))
+	{
+		PreviousParent = Parent;
+	}
+}
+
+void UDataAsset_FontTags::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// a parent which has this asset as ancestor would merge the chain forever
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UDataAsset_FontTags, Parent) && Parent && Parent->IsInParentChain(this))
+	{
+		FNotificationInfo Info(FText::Format(INVTEXT("{0} can't be the parent of {1}, it inherits from {1} already"), FText::FromString(Parent->GetName()), FText::FromString(GetName())));
+		Info.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+
+		Parent = PreviousParent.Get();
+	}
+
+	PreviousParent.Reset();
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UDataAsset_FontTags, EditedCharacter))
+	{
+		if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(FUnicodeCharacterTags, Character))
+		{
+			LoadEditedCharacter();
+		}
+		else
+		{
+			ApplyEditedCharacter();
+		}
+	}
+
+	// turning the pack off saves the tags with the asset again
+	if (!bUseTagPack)
+	{
+		MaterializePackedTags();
+	}
+
+	if (bTagsInPack)
+	{
+		// the parent may have changed, the pack only serves assets without parent
+		TagIndex.Reset();
+		TagTrie.Reset();
+	}
+	else
+	{
+		TagTableHash = TagTable.ComputeHash();
+	}
+
+	// any change (including the Parent) may affect this asset and every asset which uses it as parent
+	InvalidateCaches();
+}
+
+void UDataAsset_FontTags::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// undo restores the tags but not the snapshot (see Serialize), so the merged tags get compiled again
+	InvalidateCaches();
 }
@@ -6,6 +6,10 @@
 
 #include "Engine/DataAsset.h"
 
+#include "Serialization/BulkData.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+
 #include "DataAsset_FontTags.generated.h"
 
 /**
@@ -13,6 +17,9 @@
  */
 
 struct FSlateFontInfo;
+class FUnicodeBrowserTagIndex;
+class FUnicodeBrowserTagPack;
+class FUnicodeBrowserTagTrie;
 class UFont;
 
 USTRUCT(BlueprintType)
@@ -25,11 +32,90 @@ struct FUnicodeCharacterTags
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TArray<FString> Tags;
+};
+
+// tags which only differ in case are distinct, the search folds them anyway
+struct FUnicodeCharacterTagKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+{
+	static bool Matches(KeyInitType A, KeyInitType B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(KeyInitType Key) { return FCrc::StrCrc32(*Key); }
+};
+
+/**
+ * the tags of a set of characters, every distinct tag is stored once and referenced by its index (the tag id)
+ * the tag ids of all characters are stored back to back (CSR), so tags like "arrow" don't get copied for thousands of characters
+ * and comparing tags is comparing integers
+ */
+struct FUnicodeCharacterTagDelta;
+
+USTRUCT()
+struct UNICODEBROWSER_API FUnicodeCharacterTagTable
+{
+	GENERATED_BODY()
+
+	// tag id => tag, distinct (case-sensitive)
+	UPROPERTY(VisibleAnywhere)
+	TArray<FString> Tags;
+
+	UPROPERTY()
+	TArray<int32> Codepoints;
 
-	bool ContainsNeedle(FString Needle) const
+	// the tag ids of character i are TagIds[TagOffsets[i]] to TagIds[TagOffsets[i + 1] - 1]
+	UPROPERTY()
+	TArray<int32> TagOffsets;
+
+	UPROPERTY()
+	TArray<int32> TagIds;
+
+	int32 Num() const { return Codepoints.Num(); }
+	int32 NumTags() const { return Tags.Num(); }
+
+	TConstArrayView<int32> GetTagIds(int32 const Character) const
 	{
-		return Tags.ContainsByPredicate([Needle](FString const& Tag) { return Tag.Contains(Needle, ESearchCase::IgnoreCase); });
+		return MakeArrayView(TagIds).Mid(TagOffsets[Character], TagOffsets[Character + 1] - TagOffsets[Character]);
 	}
+
+	// interns the tags of the character, empty and duplicate tags are dropped
+	void AddCharacter(int32 Codepoint, TConstArrayView<FString> CharacterTags);
+
+	void Reset();
+
+	// identifies the content, tags are compared case-sensitive
+	uint32 ComputeHash() const;
+
+	// the table with the tags of the parent appended, characters which only the parent has are added after the own characters
+	FUnicodeCharacterTagTable MergeWithParent(FUnicodeCharacterTagTable const& Parent) const;
+
+	// the characters which need to change to turn this table into the other one, tags are compared in order and like the lookup interns them
+	// both tables have to list every codepoint only once
+	FUnicodeCharacterTagDelta Diff(FUnicodeCharacterTagTable const& Other) const;
+
+	// replaces the tags of changed characters in place, drops removed characters and appends added ones
+	// the ids of the existing tags stay valid, new tags get appended to the dictionary
+	void ApplyDelta(FUnicodeCharacterTagDelta const& Delta);
+
+	// drops the tags which no character references anymore, but only once they make up a quarter of the dictionary,
+	// so small reimports keep the tag ids stable
+	void CompactTags();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 FindOrAddTag(FString const& Tag);
+	void AddCharacterFrom(FUnicodeCharacterTagTable const& Source, int32 Character);
+	void AddCharacterIds(int32 Codepoint, TConstArrayView<int32> CharacterTagIds);
+
+	TMap<FString, int32, FDefaultSetAllocator, FUnicodeCharacterTagKeyFuncs> TagLookup; // tag => tag id, rebuilt on demand after loading
+};
+
+// the difference between two tag tables, see FUnicodeCharacterTagTable::Diff
+struct FUnicodeCharacterTagDelta
+{
+	FUnicodeCharacterTagTable Upserts; // the added and changed characters with their new tags
+	TArray<int32> Removed; // codepoints
+	int32 NumAdded = 0; // the added characters among the upserts
+
+	bool IsEmpty() const { return Upserts.Num() == 0 && Removed.IsEmpty(); }
 };
 
 UCLASS(BlueprintType, Blueprintable)
@@ -46,20 +132,57 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TArray<TObjectPtr<UFont>> Fonts;
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly)
-	TArray<FUnicodeCharacterTags> Characters;
+	UPROPERTY(VisibleAnywhere)
+	FUnicodeCharacterTagTable TagTable;
+
+	// edits the own tags of a single character, setting the character shows its tags and changing them writes them back into TagTable
+	// removing all tags removes the character, tags are only edited one character at a time so large presets stay responsive
+	UPROPERTY(EditAnywhere, Transient)
+	FUnicodeCharacterTags EditedCharacter;
+
+	// saves the tags as bulk data of the package, which isn't read when the asset gets loaded, and answers the queries from a memory mapped tag pack
+	// for presets with hundreds of thousands of characters, which then don't need to be loaded or indexed when they get selected
+	// the pack is a local cache (see GetTagPackFilename), it's built from the bulk data again whenever it's missing or outdated
+	// a preset with a parent still materializes its tags to merge the chain
+	UPROPERTY(EditAnywhere, AdvancedDisplay)
+	bool bUseTagPack = false;
+
+	// the per character tag arrays of assets which were saved before tags got interned, moved into TagTable on load
+	// assets saved them as Characters, Config/DefaultUnicodeBrowser.ini redirects the old name
+	UPROPERTY()
+	TArray<FUnicodeCharacterTags> Characters_DEPRECATED;
+
+	// the flattened parent chain, saved with the package of a preset with a parent (see Serialize) and only compiled again once the asset or an ancestor changed
+	mutable FUnicodeCharacterTagTable MergedTags;
+	mutable uint32 MergedKey = 0; // the GetCompileKey which MergedTags was compiled for
 
 	// this data is generated at runtime
-	mutable TMap<int32, int32> CodepointLookup; // Codepoint <> Characters Index
-	mutable TArray<FUnicodeCharacterTags> CharactersMerged;
+	mutable TMap<int32, int32> CodepointLookup; // Codepoint <> MergedTags character index
+	mutable TSharedPtr<FUnicodeBrowserTagIndex const> TagIndex; // substring index over MergedTags, built on the first search
+	mutable TSharedPtr<FUnicodeBrowserTagIndex const> PatchedTagIndex; // the index before MergedTags got patched, the next index reuses its tags
+	mutable TSharedPtr<FUnicodeBrowserTagTrie const> TagTrie; // completions of the tags of MergedTags, built on the first suggestion
+	mutable TSharedPtr<FUnicodeBrowserTagPack const> TagPack; // the mapped tag pack of an asset which was loaded without its tags
+	mutable uint32 CachedSerial = 0; // the CacheSerial which the runtime data was generated for
 
-	// the json file which was used to import the asset
+	// the file which was used to import the asset (a glyph tags file, UnicodeData.txt, emoji-test.txt or CLDR annotations)
 	UPROPERTY(VisibleAnywhere)
 	FString SourceFile;
 
-	TArray<FUnicodeCharacterTags>& GetCharactersMerged() const;
+	// the own tags with the tags of the whole parent chain
+	FUnicodeCharacterTagTable const& GetMergedTags() const;
 
-	TArray<int32> GetCharactersByNeedle(FString NeedleIn) const;
+	// is the asset this one or one of its ancestors, safe for cyclic chains of assets which were saved before cycles were rejected
+	bool IsInParentChain(UDataAsset_FontTags const* Asset) const;
+
+	TSharedRef<FUnicodeBrowserTagIndex const> GetTagIndex() const;
+
+	TSharedRef<FUnicodeBrowserTagTrie const> GetTagTrie() const;
+
+	// all codepoints with a tag which contains any of the comma separated needles
+	FUnicodeBrowserCodepointSet GetCharactersByNeedle(FString NeedleIn) const;
+
+	// splits a search string into its trimmed, comma separated needles
+	static void ParseNeedles(FString const& NeedleIn, TArray<FString>& OutNeedles);
 
 	bool SupportsFont(FSlateFontInfo const& FontInfo) const;
 
@@ -67,5 +190,70 @@ public:
 
 	TArray<FString> GetCodepointTags(int32 Codepoint) const;
 
-	bool ImportFromJson(FString Filename);
+	// the tag pack with the own tags if the asset was loaded without them, mapped on the first call
+	// a missing pack is built on a worker thread and this stays null until it's ready, the tags are read from the bulk data until then
+	TSharedPtr<FUnicodeBrowserTagPack const> GetTagPack() const;
+
+	// the cached pack in the Saved directory, named after the package and the hash of its tags
+	// presets never share a pack, so two presets whose tag hashes collide can't serve each other's tags
+	FString GetTagPackFilename() const;
+
+	// takes over the tags which were read from the file, only the characters which changed are touched
+	// an up to date MergedTags gets patched with the same changes instead of being compiled again
+	void ApplyImport(FString const& Filename, FUnicodeCharacterTagTable&& Table);
+
+	// invalidates the runtime data of all font tag assets, the merged data of an asset depends on its whole parent chain
+	static void InvalidateCaches();
+
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostLoad() override;
+	virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+
+private:
+	// the hashes of the own tags and of every ancestor, the merged tags are valid as long as it doesn't change
+	uint32 GetCompileKey() const;
+
+	// applies the changes of the own tags to MergedTags, which has to be up to date with the tags before the changes
+	void PatchMergedTags(FUnicodeCharacterTagDelta const& Delta) const;
+
+	// the own tags, read from the tag pack or the bulk data if the asset was loaded without them
+	FUnicodeCharacterTagTable ReadOwnTags() const;
+
+	// the tags which were saved as bulk data
+	FUnicodeCharacterTagTable ReadPackedTags() const;
+
+	// moves the tags of the tag pack back into TagTable, so they can be edited and saved with the asset again
+	void MaterializePackedTags();
+
+	// a preset without parent which was loaded without its tags answers all queries from its tag pack
+	bool IsServedFromPack() const;
+
+	// writes the tag pack from the bulk data on a worker thread, see GetTagPack
+	void BuildTagPack() const;
+
+	// maps the pack which was built for the tags with the hash key, unless the tags changed in the meantime
+	void OnTagPackBuilt(uint32 Key, bool bWritten) const;
+
+	// fills EditedCharacter with the own tags of its character
+	void LoadEditedCharacter();
+
+	// replaces the own tags of the character with the ones of EditedCharacter
+	void ApplyEditedCharacter();
+
+	UPROPERTY()
+	uint32 TagTableHash = 0; // TagTable.ComputeHash(), updated whenever the tags get replaced
+
+	FByteBulkData PackedTags; // the tags of a packed preset, only read to build the tag pack or to materialize them
+	uint32 PackedTagsKey = 0; // the TagTableHash which PackedTags holds the tags of
+
+	bool bTagsInPack = false; // TagTable was saved into PackedTags and is empty
+	mutable bool bTagPackMissing = false; // the tag pack couldn't be opened or built, so it isn't tried again
+	mutable bool bTagPackBuilding = false; // BuildTagPack is running, only one build runs at a time
+
+	TWeakObjectPtr<UDataAsset_FontTags> PreviousParent; // restored if a new parent would close a cycle
+
+	static uint32 CacheSerial;
 };
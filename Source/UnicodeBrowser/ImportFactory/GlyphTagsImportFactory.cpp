@@ -3,22 +3,73 @@
 
 #include "Factories/Factory.h"
 
-#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
+#include "Misc/Paths.h"
 
 #include "UnicodeBrowser/DataAsset_FontTags.h"
+#include "UnicodeBrowser/ImportFactory/GlyphTagsJsonReader.h"
+#include "UnicodeBrowser/ImportFactory/GlyphTagsTextReader.h"
+
+namespace UnicodeBrowser::GlyphTagsImportFactory
+{
+	// the editor asks FactoryCanImport (also through CanReimport) before every import, the header it found is kept,
+	// so the import itself neither probes the file again nor looks for the header
+	struct FProbe
+	{
+		FString Filename;
+		FDateTime Timestamp;
+		int64 Size = INDEX_NONE;
+		bool bIsGlyphTags = false;
+		FGlyphTagsJsonReader::FHeader Header;
+	};
+
+	FProbe LastProbe;
+
+	// the header of a glyph tags file, nullptr if the file isn't one, probes only files which changed since the last probe
+	FGlyphTagsJsonReader::FHeader const* ProbeHeader(FString const& Filename)
+	{
+		FFileStatData const Stat = IFileManager::Get().GetStatData(*Filename);
+		if (!Stat.bIsValid || Stat.bIsDirectory)
+			return nullptr;
+
+		if (LastProbe.Filename != Filename || LastProbe.Timestamp != Stat.ModificationTime || LastProbe.Size != Stat.FileSize)
+		{
+			LastProbe.Filename = Filename;
+			LastProbe.Timestamp = Stat.ModificationTime;
+			LastProbe.Size = Stat.FileSize;
+			LastProbe.bIsGlyphTags = FGlyphTagsJsonReader::ReadHeader(Filename, LastProbe.Header);
+		}
+
+		return LastProbe.bIsGlyphTags ? &LastProbe.Header : nullptr;
+	}
+
+	bool IsJson(FString const& Filename)
+	{
+		return FPaths::GetExtension(Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	}
+
+	// reads glyph tags files as well as the files of the UCD and CLDR which FGlyphTagsTextReader knows
+	bool ReadFile(FString const& Filename, FUnicodeCharacterTagTable& OutTable, bool& bOutCanceled)
+	{
+		if (IsJson(Filename))
+			return FGlyphTagsJsonReader::Read(Filename, OutTable, bOutCanceled, ProbeHeader(Filename));
+
+		return FGlyphTagsTextReader::Read(Filename, FGlyphTagsTextReader::ProbeFormat(Filename), OutTable, bOutCanceled);
+	}
+}
 
 UGlyphTagsImportFactory::UGlyphTagsImportFactory(FObjectInitializer const& ObjectInitializer) : Super(ObjectInitializer)
 {
 	// Factory
 	SupportedClass = UDataAsset_FontTags::StaticClass();
 	Formats.Add("json;Unicode Glyph Tags");
+	Formats.Add("txt;Unicode Character Database (UnicodeData.txt, emoji-test.txt)");
+	Formats.Add("xml;CLDR Annotations");
 	bCreateNew = false;
 	//bEditAfterNew = true;	
 	bEditorImport = true;
-	bText = true;
+	bText = false; // the readers load the files themselves
 }
 
 bool UGlyphTagsImportFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
@@ -43,49 +94,49 @@ void UGlyphTagsImportFactory::SetReimportPaths(UObject* Obj, TArray<FString> con
 
 bool UGlyphTagsImportFactory::FactoryCanImport(FString const& Filename)
 {
-	FString JsonString = "";
-	
-	if (!FFileHelper::LoadFileToString(JsonString, *Filename))
-		return false;
+	using namespace UnicodeBrowser::GlyphTagsImportFactory;
 
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	auto const Reader = TJsonReaderFactory<>::Create(JsonString);
-	FJsonSerializer::Deserialize(Reader, JsonObject);
+	if (IsJson(Filename))
+		return ProbeHeader(Filename) != nullptr;
 
-	return JsonObject->HasTypedField<EJson::String>(TEXT("format")) && JsonObject->GetStringField(TEXT("format")) == TEXT("UnicodeBrowserGlyphTags_V1");
+	return FGlyphTagsTextReader::ProbeFormat(Filename) != FGlyphTagsTextReader::EFormat::None;
 }
 
-UObject* UGlyphTagsImportFactory::ImportObject(UClass* InClass, UObject* InOuter, FName const InName, EObjectFlags const InFlags, FString const& Filename, TCHAR const* Parms, bool& OutCanceled)
+EReimportResult::Type UGlyphTagsImportFactory::Reimport(UObject* Obj)
 {
-	UDataAsset_FontTags* Object = Cast<UDataAsset_FontTags>(UFactory::ImportObject(InClass, InOuter, InName, InFlags, Filename, Parms, OutCanceled));
-	if (!OutCanceled && IsValid(Object))
+	UDataAsset_FontTags* DataAsset_FontTags = Cast<UDataAsset_FontTags>(Obj);
+	if (!IsValid(DataAsset_FontTags))
+		return EReimportResult::Type::Failed;
+
+	FString const& Filename = DataAsset_FontTags->SourceFile;
+	FUnicodeCharacterTagTable Table;
+	bool bCanceled = false;
+	if (UnicodeBrowser::GlyphTagsImportFactory::ReadFile(Filename, Table, bCanceled))
 	{
-		if (Object->ImportFromJson(Filename))
-		{
-			return Object;
-		}
+		DataAsset_FontTags->ApplyImport(Filename, MoveTemp(Table));
+		return EReimportResult::Type::Succeeded;
 	}
 
-	return Object;
-}
-
-EReimportResult::Type UGlyphTagsImportFactory::Reimport(UObject* Obj)
-{
-	UDataAsset_FontTags* DataAsset_FontTags = Cast<UDataAsset_FontTags>(Obj);
-	return IsValid(DataAsset_FontTags) && DataAsset_FontTags->ImportFromJson(DataAsset_FontTags->SourceFile) ? EReimportResult::Type::Succeeded : EReimportResult::Type::Failed;
+	return bCanceled ? EReimportResult::Type::Cancelled : EReimportResult::Type::Failed;
 };
 
-UObject* UGlyphTagsImportFactory::FactoryCreateText(
+UObject* UGlyphTagsImportFactory::FactoryCreateFile(
 	UClass* InClass,
 	UObject* InParent,
 	FName const InName,
 	EObjectFlags const Flags,
-	UObject* Context,
-	TCHAR const* Type,
-	TCHAR const*& Buffer,
-	TCHAR const* BufferEnd,
-	FFeedbackContext* Warn
+	FString const& Filename,
+	TCHAR const* Parms,
+	FFeedbackContext* Warn,
+	bool& bOutOperationCanceled
 )
 {
-	return NewObject<UDataAsset_FontTags>(InParent, InName, Flags);
+	// read first, so a broken or canceled import doesn't leave an empty asset behind
+	FUnicodeCharacterTagTable Table;
+	if (!UnicodeBrowser::GlyphTagsImportFactory::ReadFile(Filename, Table, bOutOperationCanceled))
+		return nullptr;
+
+	UDataAsset_FontTags* Object = NewObject<UDataAsset_FontTags>(InParent, InName, Flags);
+	Object->ApplyImport(Filename, MoveTemp(Table));
+	return Object;
 }
@@ -19,20 +19,17 @@ class UNICODEBROWSER_API UGlyphTagsImportFactory : public UFactory, public FReim
 public:
 	UGlyphTagsImportFactory(FObjectInitializer const& ObjectInitializer);
 
-	virtual UObject* FactoryCreateText(
+	virtual UObject* FactoryCreateFile(
 		UClass* InClass,
 		UObject* InParent,
 		FName InName,
 		EObjectFlags Flags,
-		UObject* Context,
-		TCHAR const* Type,
-		TCHAR const*& Buffer,
-		TCHAR const* BufferEnd,
-		FFeedbackContext* Warn
+		FString const& Filename,
+		TCHAR const* Parms,
+		FFeedbackContext* Warn,
+		bool& bOutOperationCanceled
 	) override;
 
-	virtual UObject* ImportObject(UClass* InClass, UObject* InOuter, FName InName, EObjectFlags InFlags, FString const& Filename, TCHAR const* Parms, bool& OutCanceled) override;
-
 	virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
 	virtual bool FactoryCanImport(FString const& Filename) override;
 
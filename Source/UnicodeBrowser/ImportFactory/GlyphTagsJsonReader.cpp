@@ -0,0 +1,481 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "GlyphTagsJsonReader.h"
+
+#include "HAL/FileManager.h"
+
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+
+#include "Serialization/JsonReader.h"
+
+#include "String/Find.h"
+
+#include "UnicodeBrowser/DataAsset_FontTags.h"
+
+namespace UnicodeBrowser::GlyphTagsJsonReader
+{
+	constexpr int64 ChunkSize = 1 << 20;
+	constexpr int64 ProbeSize = 64 << 10; // bytes at the start and at the end of a file which a header probe reads at most
+	constexpr int32 GlyphsPerProgressFrame = 1024;
+
+	// hands out a UTF-8 file as TCHARs, decoded one chunk at a time, TJsonReader reads it character by character
+	class FUtf8Archive final : public FArchive
+	{
+	public:
+		// only the first MaxBytes of the file are decoded
+		explicit FUtf8Archive(TUniquePtr<FArchive>&& InnerIn, int64 const MaxBytes = MAX_int64)
+			: Inner(MoveTemp(InnerIn))
+			, Size(FMath::Min(Inner->TotalSize(), MaxBytes))
+		{
+			SetIsLoading(true);
+		}
+
+		virtual void Serialize(void* Data, int64 Length) override
+		{
+			TCHAR* Out = static_cast<TCHAR*>(Data);
+			int64 NumChars = Length / sizeof(TCHAR);
+			while (NumChars > 0)
+			{
+				if (Position == Decoded.Num() && !Refill())
+				{
+					FMemory::Memzero(Out, NumChars * sizeof(TCHAR));
+					SetError();
+					return;
+				}
+
+				int64 const Count = FMath::Min<int64>(NumChars, Decoded.Num() - Position);
+				FMemory::Memcpy(Out, &Decoded[Position], Count * sizeof(TCHAR));
+				Out += Count;
+				NumChars -= Count;
+				Position += Count;
+			}
+		}
+
+		virtual bool AtEnd() override
+		{
+			return Position == Decoded.Num() && !Refill();
+		}
+
+		// position within the file in bytes, for the progress
+		virtual int64 Tell() override { return Inner->Tell(); }
+		virtual int64 TotalSize() override { return Size; }
+
+		virtual FString GetArchiveName() const override { return TEXT("FUtf8Archive"); }
+
+	private:
+		bool Refill()
+		{
+			Position = 0;
+			Decoded.Reset();
+
+			while (Decoded.IsEmpty())
+			{
+				int64 const NumToRead = FMath::Min(ChunkSize, Size - Inner->Tell());
+				if (NumToRead <= 0 && Pending.IsEmpty())
+					return false;
+
+				bool const bLastChunk = Inner->Tell() + NumToRead >= Size;
+
+				int32 const NumPending = Pending.Num();
+				Pending.AddUninitialized(static_cast<int32>(NumToRead));
+				Inner->Serialize(Pending.GetData() + NumPending, NumToRead);
+
+				int32 Start = 0;
+				if (bAtStart)
+				{
+					bAtStart = false;
+					if (Pending.Num() >= 3 && Pending[0] == 0xEF && Pending[1] == 0xBB && Pending[2] == 0xBF)
+					{
+						Start = 3;
+					}
+				}
+
+				// a sequence which is cut by the end of the chunk is decoded with the next chunk
+				int32 End = Pending.Num();
+				if (!bLastChunk)
+				{
+					int32 Lead = End - 1;
+					while (Lead > Start && End - Lead < 4 && (Pending[Lead] & 0xC0) == 0x80)
+					{
+						--Lead;
+					}
+
+					uint8 const LeadByte = Pending[Lead];
+					int32 const SequenceLength = LeadByte >= 0xF0 ? 4 : LeadByte >= 0xE0 ? 3 : LeadByte >= 0xC0 ? 2 : 1;
+					if (Lead + SequenceLength > End)
+					{
+						End = Lead;
+					}
+				}
+
+				auto const Converted = StringCast<TCHAR>(reinterpret_cast<UTF8CHAR const*>(Pending.GetData() + Start), End - Start);
+				Decoded.Append(Converted.Get(), Converted.Length());
+
+				if (bLastChunk)
+				{
+					Pending.Reset();
+				}
+				else
+				{
+					Pending.RemoveAt(0, End);
+				}
+			}
+
+			return true;
+		}
+
+		TUniquePtr<FArchive> Inner;
+		int64 Size = 0;
+		TArray<uint8> Pending; // bytes which were read, but not decoded yet
+		TArray<TCHAR> Decoded;
+		int32 Position = 0; // next character within Decoded
+		bool bAtStart = true;
+	};
+
+	struct FPass
+	{
+		FGlyphTagsJsonReader::FHeader& Header;
+		FUnicodeCharacterTagTable& Table;
+		bool bHeaderKnown = false; // the second pass only reads the glyphs
+		bool bHeaderOnly = false; // a probe stops in front of the glyphs
+		bool bGlyphsPending = false; // the glyphs came before the header and were skipped
+		int32 NumGlyphs = 0;
+		bool bCanceled = false;
+
+		// a codepoint may be listed by more than one glyph, the tags of the later ones are merged once all glyphs were read
+		TMap<int32, int32> CharacterIndices;
+		TMap<int32, TArray<FString>> DuplicateTags; // character index => tags of the later glyphs
+	};
+
+	// the characters which were listed more than once get the tags of all their glyphs
+	void MergeDuplicateTags(FPass& Pass)
+	{
+		if (Pass.DuplicateTags.IsEmpty())
+			return;
+
+		FUnicodeCharacterTagTable const Table = MoveTemp(Pass.Table);
+		Pass.Table.Reset();
+
+		TArray<FString> CharacterTags;
+		for (int32 Character = 0; Character < Table.Num(); ++Character)
+		{
+			CharacterTags.Reset();
+			for (int32 const TagId : Table.GetTagIds(Character))
+			{
+				CharacterTags.Add(Table.Tags[TagId]);
+			}
+
+			if (TArray<FString> const* Tags = Pass.DuplicateTags.Find(Character))
+			{
+				CharacterTags.Append(*Tags);
+			}
+
+			Pass.Table.AddCharacter(Table.Codepoints[Character], CharacterTags);
+		}
+	}
+
+	// the string value of a tag field, numbers and booleans are converted like FJsonValue::TryGetString does
+	bool GetValueAsString(TJsonReader<TCHAR>& Reader, EJsonNotation const Notation, FString& OutValue)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::String:
+			OutValue = Reader.GetValueAsString();
+			return true;
+		case EJsonNotation::Number:
+			OutValue = Reader.GetValueAsNumberString();
+			return true;
+		case EJsonNotation::Boolean:
+			OutValue = Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool ReadGlyphs(TJsonReader<TCHAR>& Reader, FArchive& Archive, FScopedSlowTask& SlowTask, FPass& Pass)
+	{
+		FGlyphTagsJsonReader::FHeader const& Header = Pass.Header;
+
+		TMap<FString, int32> TagFieldIndices;
+		for (int32 TagField = 0; TagField < Header.TagFields.Num(); ++TagField)
+		{
+			TagFieldIndices.Add(Header.TagFields[TagField], TagField);
+		}
+
+		// the decimal field wins if both are given
+		bool const bDecimal = !Header.CodepointFieldDecimal.IsEmpty();
+		FString const& CodepointField = bDecimal ? Header.CodepointFieldDecimal : Header.CodepointFieldHexadecimal;
+
+		TArray<FString> Tags;
+		Tags.SetNum(Header.TagFields.Num());
+		int64 ReportedBytes = Archive.Tell();
+
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (Notation == EJsonNotation::ArrayStart && !Reader.SkipArray())
+				return false;
+
+			if (Notation != EJsonNotation::ObjectStart)
+				continue;
+
+			++Pass.NumGlyphs;
+			for (FString& Tag : Tags)
+			{
+				Tag.Reset();
+			}
+
+			int32 Codepoint = 0;
+			bool bValidCodepoint = false;
+
+			while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd)
+			{
+				if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+				{
+					if (!(Notation == EJsonNotation::ObjectStart ? Reader.SkipObject() : Reader.SkipArray()))
+						return false;
+
+					continue;
+				}
+
+				FString const& Identifier = Reader.GetIdentifier();
+				if (Identifier == CodepointField)
+				{
+					if (bDecimal && Notation == EJsonNotation::Number)
+					{
+						Codepoint = static_cast<int32>(Reader.GetValueAsNumber());
+						bValidCodepoint = true;
+					}
+					else if (bDecimal && Notation == EJsonNotation::String)
+					{
+						Codepoint = FCString::Strtoi(*Reader.GetValueAsString(), nullptr, 10);
+						bValidCodepoint = true;
+					}
+					else if (!bDecimal && Notation == EJsonNotation::String && Reader.GetValueAsString().StartsWith(TEXT("0x"), ESearchCase::IgnoreCase))
+					{
+						Codepoint = FCString::Strtoi(*Reader.GetValueAsString(), nullptr, 16);
+						bValidCodepoint = true;
+					}
+				}
+				else if (int32 const* TagField = TagFieldIndices.Find(Identifier))
+				{
+					GetValueAsString(Reader, Notation, Tags[*TagField]);
+				}
+			}
+
+			if (Notation != EJsonNotation::ObjectEnd)
+				return false;
+
+			// glyphs without a codepoint are skipped
+			if (bValidCodepoint)
+			{
+				int32 const Character = Pass.CharacterIndices.FindOrAdd(Codepoint, Pass.Table.Num());
+				if (Character == Pass.Table.Num())
+				{
+					Pass.Table.AddCharacter(Codepoint, Tags);
+				}
+				else
+				{
+					Pass.DuplicateTags.FindOrAdd(Character).Append(Tags);
+				}
+			}
+
+			if (Pass.NumGlyphs % GlyphsPerProgressFrame == 0)
+			{
+				int64 const Bytes = Archive.Tell();
+				SlowTask.EnterProgressFrame(static_cast<float>(Bytes - ReportedBytes));
+				ReportedBytes = Bytes;
+
+				if (SlowTask.ShouldCancel())
+				{
+					Pass.bCanceled = true;
+					return false;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool ReadRootObject(TSharedRef<TJsonReader<TCHAR>> const& Reader, FUtf8Archive& Archive, FScopedSlowTask* SlowTask, FPass& Pass)
+	{
+		EJsonNotation Notation;
+		if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+			return false;
+
+		FGlyphTagsJsonReader::FHeader& Header = Pass.Header;
+		while (Reader->ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd)
+		{
+			FString const& Identifier = Reader->GetIdentifier();
+
+			if (Notation == EJsonNotation::ArrayStart && Identifier == TEXT("glyphs"))
+			{
+				if (Header.IsValid() && Pass.bHeaderOnly)
+					return true;
+
+				if (Header.IsValid())
+				{
+					if (!ReadGlyphs(*Reader, Archive, *SlowTask, Pass))
+						return false;
+				}
+				else
+				{
+					Pass.bGlyphsPending = true;
+					if (!Reader->SkipArray())
+						return false;
+				}
+			}
+			else if (Notation == EJsonNotation::ArrayStart && Identifier == TEXT("tagFields") && !Pass.bHeaderKnown)
+			{
+				while (Reader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+				{
+					if (Notation == EJsonNotation::String && !Reader->GetValueAsString().IsEmpty())
+					{
+						Header.TagFields.Add(Reader->GetValueAsString());
+					}
+				}
+			}
+			else if (Notation == EJsonNotation::String && !Pass.bHeaderKnown)
+			{
+				if (Identifier == TEXT("format"))
+				{
+					Header.Format = Reader->GetValueAsString();
+				}
+				else if (Identifier == TEXT("codepointFieldDecimal"))
+				{
+					Header.CodepointFieldDecimal = Reader->GetValueAsString();
+				}
+				else if (Identifier == TEXT("codepointFieldHexadecimal"))
+				{
+					Header.CodepointFieldHexadecimal = Reader->GetValueAsString();
+				}
+			}
+			else if (Notation == EJsonNotation::ObjectStart && !Reader->SkipObject())
+			{
+				return false;
+			}
+			else if (Notation == EJsonNotation::ArrayStart && !Reader->SkipArray())
+			{
+				return false;
+			}
+		}
+
+		return Notation == EJsonNotation::ObjectEnd;
+	}
+
+	// parses the root object, the slow task is only needed if the glyphs are read
+	bool ReadRoot(FString const& Filename, FUtf8Archive& Archive, FScopedSlowTask* SlowTask, FPass& Pass)
+	{
+		TSharedRef<TJsonReader<TCHAR>> const Reader = TJsonReaderFactory<TCHAR>::Create(&Archive);
+		bool const bSuccess = ReadRootObject(Reader, Archive, SlowTask, Pass);
+
+		// running out of bytes is expected for a probe and a canceled import isn't an error
+		if (!bSuccess && !Pass.bHeaderOnly && !Pass.bCanceled)
+		{
+			FString const& Error = Reader->GetErrorMessage();
+			UE_LOG(LogTemp, Error, TEXT("[FGlyphTagsJsonReader::Read] %s: %s"), *Filename, Error.IsEmpty() ? TEXT("the file isn't a glyph tags object") : *Error);
+		}
+
+		return bSuccess;
+	}
+
+	bool ReadPass(FString const& Filename, FPass& Pass)
+	{
+		TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename));
+		if (!File)
+			return false;
+
+		FUtf8Archive Archive(MoveTemp(File));
+		FScopedSlowTask SlowTask(static_cast<float>(Archive.TotalSize()), FText::Format(INVTEXT("Importing {0}"), FText::FromString(FPaths::GetCleanFilename(Filename))));
+		SlowTask.MakeDialogDelayed(0.5f, true);
+
+		return ReadRoot(Filename, Archive, &SlowTask, Pass);
+	}
+
+	// the format of a file which lists its header after the glyphs, found by looking for the "format" field in the last bytes
+	FString FindTrailingFormat(FString const& Filename)
+	{
+		TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+		if (!File || File->TotalSize() <= ProbeSize)
+			return {};
+
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(ProbeSize);
+		File->Seek(File->TotalSize() - ProbeSize);
+		File->Serialize(Bytes.GetData(), ProbeSize);
+
+		auto const Converted = StringCast<TCHAR>(reinterpret_cast<UTF8CHAR const*>(Bytes.GetData()), Bytes.Num());
+		FStringView const Tail(Converted.Get(), Converted.Length());
+
+		int32 const Field = UE::String::FindLast(Tail, TEXT("\"format\""));
+		if (Field == INDEX_NONE)
+			return {};
+
+		FStringView Value = Tail.RightChop(Field + 8).TrimStart();
+		if (!Value.StartsWith(TEXT(':')))
+			return {};
+
+		Value = Value.RightChop(1).TrimStart();
+		if (!Value.StartsWith(TEXT('"')))
+			return {};
+
+		Value.RightChopInline(1);
+		int32 const End = UE::String::FindFirstChar(Value, TEXT('"'));
+		return End == INDEX_NONE ? FString() : FString(Value.Left(End));
+	}
+}
+
+bool FGlyphTagsJsonReader::Read(FString const& Filename, FUnicodeCharacterTagTable& OutTable, bool& bOutCanceled, FHeader const* KnownHeader)
+{
+	using namespace UnicodeBrowser::GlyphTagsJsonReader;
+
+	FHeader Header = KnownHeader && KnownHeader->IsValid() ? *KnownHeader : FHeader();
+	FPass Pass{Header, OutTable};
+	Pass.bHeaderKnown = Header.IsValid();
+
+	bool bSuccess = ReadPass(Filename, Pass);
+
+	// the header came after the glyphs, now that it's known the glyphs can be read
+	if (bSuccess && Pass.bGlyphsPending && Header.IsValid())
+	{
+		Pass.bHeaderKnown = true;
+		bSuccess = ReadPass(Filename, Pass);
+	}
+
+	if (bSuccess)
+	{
+		MergeDuplicateTags(Pass);
+	}
+
+	bOutCanceled = Pass.bCanceled;
+	return bSuccess && Header.IsValid() && Pass.NumGlyphs > 0;
+}
+
+bool FGlyphTagsJsonReader::ReadHeader(FString const& Filename, FHeader& OutHeader)
+{
+	using namespace UnicodeBrowser::GlyphTagsJsonReader;
+
+	OutHeader = FHeader();
+
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+	if (!File)
+		return false;
+
+	FUtf8Archive Archive(MoveTemp(File), ProbeSize);
+	FUnicodeCharacterTagTable Unused;
+	FPass Pass{OutHeader, Unused};
+	Pass.bHeaderOnly = true;
+	ReadRoot(Filename, Archive, nullptr, Pass);
+
+	if (OutHeader.Format.IsEmpty())
+	{
+		OutHeader.Format = FindTrailingFormat(Filename);
+	}
+
+	return OutHeader.Format == FormatName;
+}
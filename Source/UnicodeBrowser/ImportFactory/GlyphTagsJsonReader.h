@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnicodeCharacterTagTable;
+
+/**
+ * streaming reader for glyph tag files (format UnicodeBrowserGlyphTags_V1)
+ * the file is decoded from UTF-8 chunk by chunk and parsed token by token, every glyph goes straight into the tag table,
+ * so neither the file nor a JSON object tree is ever held in memory
+ * the header fields are expected in front of "glyphs", files which list them afterward are read a second time
+ */
+class UNICODEBROWSER_API FGlyphTagsJsonReader
+{
+public:
+	struct FHeader
+	{
+		FString Format;
+		FString CodepointFieldDecimal;
+		FString CodepointFieldHexadecimal;
+		TArray<FString> TagFields;
+
+		bool IsValid() const { return !TagFields.IsEmpty() && (!CodepointFieldDecimal.IsEmpty() || !CodepointFieldHexadecimal.IsEmpty()); }
+	};
+
+	static constexpr TCHAR const* FormatName = TEXT("UnicodeBrowserGlyphTags_V1");
+
+	// probes the format without reading the glyphs, at most the first and the last 64 KB of the file are read
+	// the header is complete if the file lists it in front of the glyphs, otherwise only the format is known
+	static bool ReadHeader(FString const& Filename, FHeader& OutHeader);
+
+	// reads all glyphs of the file into the table, showing a progress dialog which allows to cancel
+	// a valid header of a previous probe saves looking for it, which matters most for files that list it after the glyphs
+	// returns false if the file can't be read, isn't a glyph tags file, has no glyphs or the import got cancelled
+	static bool Read(FString const& Filename, FUnicodeCharacterTagTable& OutTable, bool& bOutCanceled, FHeader const* KnownHeader = nullptr);
+};
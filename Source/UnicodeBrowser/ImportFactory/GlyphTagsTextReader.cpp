@@ -0,0 +1,428 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "GlyphTagsTextReader.h"
+
+#include "Async/ParallelFor.h"
+
+#include "HAL/FileManager.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+
+#include "UnicodeBrowser/DataAsset_FontTags.h"
+
+namespace UnicodeBrowser::GlyphTagsTextReader
+{
+	constexpr int64 ProbeSize = 4 << 10;
+	constexpr int32 MinChunkSize = 64 << 10;
+	constexpr int32 MaxChunks = 256;
+
+	struct FLine
+	{
+		enum class EKind : uint8
+		{
+			Character,
+			Group, // emoji-test.txt, applies to the characters up to the next group
+			Subgroup,
+		};
+
+		EKind Kind = EKind::Character;
+		int32 Codepoint = 0;
+		TArray<FString, TInlineAllocator<4>> Tags;
+	};
+
+	using FFields = TArray<FAnsiStringView, TInlineAllocator<16>>;
+
+	FAnsiStringView SkipByteOrderMark(FAnsiStringView const Text)
+	{
+		return Text.StartsWith("\xEF\xBB\xBF") ? Text.RightChop(3) : Text;
+	}
+
+	FString ToString(FAnsiStringView const Utf8)
+	{
+		auto const Converted = StringCast<TCHAR>(reinterpret_cast<UTF8CHAR const*>(Utf8.GetData()), Utf8.Len());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	void SplitFields(FAnsiStringView const Line, ANSICHAR const Delimiter, FFields& OutFields)
+	{
+		OutFields.Reset();
+		int32 Start = 0;
+		for (int32 Index = 0; Index <= Line.Len(); ++Index)
+		{
+			if (Index == Line.Len() || Line[Index] == Delimiter)
+			{
+				OutFields.Add(Line.Mid(Start, Index - Start).TrimStartAndEnd());
+				Start = Index + 1;
+			}
+		}
+	}
+
+	bool ParseHex(FAnsiStringView const Hex, int32& OutValue)
+	{
+		if (Hex.IsEmpty() || Hex.Len() > 6)
+			return false;
+
+		int32 Value = 0;
+		for (ANSICHAR const Character : Hex)
+		{
+			if (!FCharAnsi::IsHexDigit(Character))
+				return false;
+
+			Value = Value * 16 + FParse::HexDigit(Character);
+		}
+
+		OutValue = Value;
+		return true;
+	}
+
+	// the codepoint of a string which holds a single character, an emoji presentation selector after it is ignored
+	bool ParseSingleCharacter(FAnsiStringView const Utf8, int32& OutCodepoint)
+	{
+		int32 Codepoints[2];
+		int32 NumCodepoints = 0;
+		for (int32 Index = 0; Index < Utf8.Len();)
+		{
+			uint8 const Lead = Utf8[Index];
+			int32 const Length = Lead < 0x80 ? 1 : Lead >= 0xF0 ? 4 : Lead >= 0xE0 ? 3 : Lead >= 0xC0 ? 2 : 0;
+			if (Length == 0 || Index + Length > Utf8.Len() || NumCodepoints == UE_ARRAY_COUNT(Codepoints))
+				return false;
+
+			int32 Codepoint = Length == 1 ? Lead : Lead & (0xFF >> (Length + 1));
+			for (int32 Continuation = 1; Continuation < Length; ++Continuation)
+			{
+				Codepoint = (Codepoint << 6) | (Utf8[Index + Continuation] & 0x3F);
+			}
+
+			Codepoints[NumCodepoints++] = Codepoint;
+			Index += Length;
+		}
+
+		if (NumCodepoints == 0 || (NumCodepoints == 2 && Codepoints[1] != 0xFE0F))
+			return false;
+
+		OutCodepoint = Codepoints[0];
+		return true;
+	}
+
+	FString DecodeEntities(FString Text)
+	{
+		if (Text.Contains(TEXT("&"), ESearchCase::CaseSensitive))
+		{
+			Text.ReplaceInline(TEXT("&lt;"), TEXT("<"), ESearchCase::CaseSensitive);
+			Text.ReplaceInline(TEXT("&gt;"), TEXT(">"), ESearchCase::CaseSensitive);
+			Text.ReplaceInline(TEXT("&quot;"), TEXT("\""), ESearchCase::CaseSensitive);
+			Text.ReplaceInline(TEXT("&apos;"), TEXT("'"), ESearchCase::CaseSensitive);
+			Text.ReplaceInline(TEXT("&amp;"), TEXT("&"), ESearchCase::CaseSensitive);
+		}
+
+		return Text;
+	}
+
+	// 0041;LATIN CAPITAL LETTER A;Lu;0;L;;;;;N;;;;0061;
+	// the name and the Unicode 1.0 name become the tags, like TagA and TagB of Example.json
+	void ParseUnicodeData(FAnsiStringView const Line, FFields& Fields, TArray<FLine>& OutLines)
+	{
+		SplitFields(Line, ';', Fields);
+
+		FLine Result;
+		if (Fields.Num() < 11 || !ParseHex(Fields[0], Result.Codepoint))
+			return;
+
+		// the first and the last character of a range share a name, the characters in between aren't listed
+		if (Fields[1].StartsWith('<') && (Fields[1].EndsWith(", First>") || Fields[1].EndsWith(", Last>")))
+			return;
+
+		Result.Tags.Add(ToString(Fields[1]));
+		if (!Fields[10].IsEmpty())
+		{
+			Result.Tags.Add(ToString(Fields[10]));
+		}
+
+		OutLines.Add(MoveTemp(Result));
+	}
+
+	// # group: Smileys & Emotion
+	// # subgroup: face-smiling
+	// 1F600 ; fully-qualified # 😀 E1.0 grinning face
+	// sequences of more than one character can't be tagged, except a character with its emoji presentation selector
+	void ParseEmojiTest(FAnsiStringView const Line, FFields& Fields, TArray<FLine>& OutLines)
+	{
+		if (Line.StartsWith("# group:"))
+		{
+			OutLines.Add({FLine::EKind::Group, 0, {ToString(Line.RightChop(8).TrimStartAndEnd())}});
+			return;
+		}
+
+		if (Line.StartsWith("# subgroup:"))
+		{
+			OutLines.Add({FLine::EKind::Subgroup, 0, {ToString(Line.RightChop(11).TrimStartAndEnd())}});
+			return;
+		}
+
+		int32 Semicolon = INDEX_NONE;
+		int32 Hash = INDEX_NONE;
+		if (Line.StartsWith('#') || !Line.FindChar(';', Semicolon) || !Line.FindChar('#', Hash) || Hash < Semicolon)
+			return;
+
+		SplitFields(Line.Left(Semicolon), ' ', Fields);
+		Fields.RemoveAll([](FAnsiStringView const Field) { return Field.IsEmpty(); });
+
+		FLine Result;
+		int32 Selector = 0;
+		if (Fields.IsEmpty() || Fields.Num() > 2 || !ParseHex(Fields[0], Result.Codepoint) || (Fields.Num() == 2 && (!ParseHex(Fields[1], Selector) || Selector != 0xFE0F)))
+			return;
+
+		// the comment is the emoji, the version it came with and its name
+		SplitFields(Line.RightChop(Hash + 1).TrimStart(), ' ', Fields);
+		int32 FirstWord = 1;
+		if (Fields.Num() > FirstWord && Fields[FirstWord].StartsWith('E') && Fields[FirstWord].Len() > 1 && FCharAnsi::IsDigit(Fields[FirstWord][1]))
+		{
+			++FirstWord;
+		}
+
+		if (Fields.Num() <= FirstWord)
+			return;
+
+		FAnsiStringView const Name = Line.RightChop(static_cast<int32>(Fields[FirstWord].GetData() - Line.GetData()));
+		Result.Tags.Add(ToString(Name.TrimEnd()));
+		OutLines.Add(MoveTemp(Result));
+	}
+
+	// <annotation cp="😀">face | grin | grinning face</annotation>
+	// <annotation cp="😀" type="tts">grinning face</annotation>
+	void ParseCldrAnnotation(FAnsiStringView const Line, FFields& Fields, TArray<FLine>& OutLines)
+	{
+		FAnsiStringView Element = Line.TrimStart();
+		if (!Element.StartsWith("<annotation "))
+			return;
+
+		int32 const Attribute = Element.Find("cp=\"");
+		if (Attribute == INDEX_NONE)
+			return;
+
+		FAnsiStringView const AfterAttribute = Element.RightChop(Attribute + 4);
+		int32 Quote = INDEX_NONE;
+		if (!AfterAttribute.FindChar('"', Quote))
+			return;
+
+		FAnsiStringView Character = AfterAttribute.Left(Quote);
+		static ANSICHAR const* const Entities[][2] = {{"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&apos;", "'"}, {"&amp;", "&"}};
+		for (ANSICHAR const* const* Entity : Entities)
+		{
+			if (Character.Equals(Entity[0], ESearchCase::CaseSensitive))
+			{
+				Character = Entity[1];
+			}
+		}
+
+		FLine Result;
+		if (!ParseSingleCharacter(Character, Result.Codepoint))
+			return;
+
+		FAnsiStringView const AfterCharacter = AfterAttribute.RightChop(Quote + 1);
+		int32 TextStart = INDEX_NONE;
+		int32 const TextEnd = Element.Find("</annotation>");
+		if (!AfterCharacter.FindChar('>', TextStart) || TextEnd == INDEX_NONE)
+			return;
+
+		TextStart += static_cast<int32>(AfterCharacter.GetData() - Element.GetData()) + 1;
+		if (TextEnd < TextStart)
+			return;
+
+		SplitFields(Element.Mid(TextStart, TextEnd - TextStart), '|', Fields);
+		for (FAnsiStringView const Keyword : Fields)
+		{
+			if (!Keyword.IsEmpty())
+			{
+				Result.Tags.Add(DecodeEntities(ToString(Keyword)));
+			}
+		}
+
+		if (!Result.Tags.IsEmpty())
+		{
+			OutLines.Add(MoveTemp(Result));
+		}
+	}
+
+	void ParseChunk(FAnsiStringView const Text, FGlyphTagsTextReader::EFormat const Format, TArray<FLine>& OutLines)
+	{
+		FFields Fields;
+		int32 Start = 0;
+		while (Start < Text.Len())
+		{
+			int32 End = Start;
+			while (End < Text.Len() && Text[End] != '\n')
+			{
+				++End;
+			}
+
+			FAnsiStringView const Line = Text.Mid(Start, End - Start).TrimEnd();
+			switch (Format)
+			{
+			case FGlyphTagsTextReader::EFormat::UnicodeData:
+				ParseUnicodeData(Line, Fields, OutLines);
+				break;
+			case FGlyphTagsTextReader::EFormat::EmojiTest:
+				ParseEmojiTest(Line, Fields, OutLines);
+				break;
+			case FGlyphTagsTextReader::EFormat::CldrAnnotations:
+				ParseCldrAnnotation(Line, Fields, OutLines);
+				break;
+			default:
+				break;
+			}
+
+			Start = End + 1;
+		}
+	}
+}
+
+FGlyphTagsTextReader::EFormat FGlyphTagsTextReader::ProbeFormat(FString const& Filename)
+{
+	using namespace UnicodeBrowser::GlyphTagsTextReader;
+
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+	if (!File)
+		return EFormat::None;
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(FMath::Min(File->TotalSize(), ProbeSize)));
+	File->Serialize(Bytes.GetData(), Bytes.Num());
+
+	FAnsiStringView const Head = SkipByteOrderMark(FAnsiStringView(reinterpret_cast<ANSICHAR const*>(Bytes.GetData()), Bytes.Num()));
+
+	if (Head.Find("<ldml") != INDEX_NONE && Head.Find("<annotations>") != INDEX_NONE)
+		return EFormat::CldrAnnotations;
+
+	if (Head.Find("# emoji-test.txt") != INDEX_NONE)
+		return EFormat::EmojiTest;
+
+	// UnicodeData.txt has no header, its lines have 15 fields
+	int32 LineEnd = INDEX_NONE;
+	FFields Fields;
+	int32 Codepoint = 0;
+	if (Head.FindChar('\n', LineEnd))
+	{
+		SplitFields(Head.Left(LineEnd).TrimEnd(), ';', Fields);
+		if (Fields.Num() == 15 && ParseHex(Fields[0], Codepoint))
+			return EFormat::UnicodeData;
+	}
+
+	return EFormat::None;
+}
+
+bool FGlyphTagsTextReader::Read(FString const& Filename, EFormat const Format, FUnicodeCharacterTagTable& OutTable, bool& bOutCanceled)
+{
+	using namespace UnicodeBrowser::GlyphTagsTextReader;
+
+	bOutCanceled = false;
+	if (Format == EFormat::None)
+		return false;
+
+	FScopedSlowTask SlowTask(3.f, FText::Format(INVTEXT("Importing {0}"), FText::FromString(FPaths::GetCleanFilename(Filename))));
+	SlowTask.MakeDialogDelayed(0.5f, true);
+
+	SlowTask.EnterProgressFrame();
+	TArray64<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename) || Bytes.Num() > MAX_int32)
+		return false;
+
+	FAnsiStringView const Text = SkipByteOrderMark(FAnsiStringView(reinterpret_cast<ANSICHAR const*>(Bytes.GetData()), static_cast<int32>(Bytes.Num())));
+
+	// the chunks end behind a line break, so no line is split
+	TArray<int32> ChunkStarts;
+	int32 const NumChunks = FMath::Clamp(Text.Len() / MinChunkSize, 1, MaxChunks);
+	ChunkStarts.Add(0);
+	for (int32 Chunk = 1; Chunk < NumChunks; ++Chunk)
+	{
+		int32 Start = FMath::Max(ChunkStarts.Last(), static_cast<int32>(static_cast<int64>(Text.Len()) * Chunk / NumChunks));
+		while (Start < Text.Len() && Text[Start - 1] != '\n')
+		{
+			++Start;
+		}
+
+		ChunkStarts.Add(Start);
+	}
+	ChunkStarts.Add(Text.Len());
+
+	if (SlowTask.ShouldCancel())
+	{
+		bOutCanceled = true;
+		return false;
+	}
+
+	SlowTask.EnterProgressFrame();
+	TArray<TArray<FLine>> ChunkLines;
+	ChunkLines.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 const Chunk)
+	{
+		ParseChunk(Text.Mid(ChunkStarts[Chunk], ChunkStarts[Chunk + 1] - ChunkStarts[Chunk]), Format, ChunkLines[Chunk]);
+	});
+
+	if (SlowTask.ShouldCancel())
+	{
+		bOutCanceled = true;
+		return false;
+	}
+
+	// a character may be listed more than once (e.g. with and without presentation selector, or as keywords and as spoken name)
+	SlowTask.EnterProgressFrame();
+	TMap<int32, int32> CharacterIndices;
+	TArray<int32> Codepoints;
+	TArray<TArray<FString>> CharacterTags;
+	FString Group;
+	FString Subgroup;
+	for (TArray<FLine>& Lines : ChunkLines)
+	{
+		for (FLine& Line : Lines)
+		{
+			if (Line.Kind == FLine::EKind::Group)
+			{
+				Group = MoveTemp(Line.Tags[0]);
+				Subgroup.Reset();
+				continue;
+			}
+
+			if (Line.Kind == FLine::EKind::Subgroup)
+			{
+				Subgroup = MoveTemp(Line.Tags[0]);
+				continue;
+			}
+
+			int32 const Character = CharacterIndices.FindOrAdd(Line.Codepoint, Codepoints.Num());
+			if (Character == Codepoints.Num())
+			{
+				Codepoints.Add(Line.Codepoint);
+				CharacterTags.AddDefaulted();
+			}
+
+			for (FString& Tag : Line.Tags)
+			{
+				CharacterTags[Character].AddUnique(MoveTemp(Tag));
+			}
+
+			if (!Group.IsEmpty())
+			{
+				CharacterTags[Character].AddUnique(Group);
+			}
+
+			if (!Subgroup.IsEmpty())
+			{
+				CharacterTags[Character].AddUnique(Subgroup);
+			}
+		}
+	}
+
+	if (Codepoints.IsEmpty())
+		return false;
+
+	for (int32 Character = 0; Character < Codepoints.Num(); ++Character)
+	{
+		OutTable.AddCharacter(Codepoints[Character], CharacterTags[Character]);
+	}
+
+	return true;
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FUnicodeCharacterTagTable;
+
+/**
+ * reader for the tag sources of the Unicode Consortium, so they don't need to be converted to glyph tags files first
+ * - UnicodeData.txt of the UCD: the name and the Unicode 1.0 name of every character
+ * - emoji-test.txt: the name, group and subgroup of every single character emoji
+ * - CLDR annotations (common/annotations/<locale>.xml): the keywords and the spoken name of every single character emoji
+ * the lines of a file are parsed in chunks on worker threads, the results are merged into the tag table in file order
+ */
+class UNICODEBROWSER_API FGlyphTagsTextReader
+{
+public:
+	enum class EFormat : uint8
+	{
+		None,
+		UnicodeData,
+		EmojiTest,
+		CldrAnnotations,
+	};
+
+	// recognizes the format by the first few KB of the file
+	static EFormat ProbeFormat(FString const& Filename);
+
+	// reads all characters of the file into the table, showing a progress dialog which allows to cancel
+	// returns false if the file can't be read, has no characters or the import got cancelled
+	static bool Read(FString const& Filename, EFormat Format, FUnicodeCharacterTagTable& OutTable, bool& bOutCanceled);
+};
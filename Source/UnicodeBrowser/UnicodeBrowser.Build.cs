@@ -27,6 +27,7 @@ public class UnicodeBrowser : ModuleRules
 				"CoreUObject",
 				"DeveloperSettings",
 				"EditorFramework",
+				"EditorSubsystem",
 				"Engine",
 				"InputCore",
 				"Json", // required for importer
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+
+void FUnicodeBrowserCodepointSet::Add(int32 const Codepoint)
+{
+	if (Codepoint < 0)
+		return;
+
+	int32 const ChunkIndex = Codepoint >> ChunkBits;
+	if (ChunkIndex >= Chunks.Num())
+	{
+		Chunks.SetNum(ChunkIndex + 1);
+	}
+
+	FChunk& Chunk = Chunks[ChunkIndex];
+	uint16 const Value = static_cast<uint16>(Codepoint & (ChunkSize - 1));
+
+	if (Chunk.IsBitmap())
+	{
+		uint64& Word = Chunk.Bits[Value >> 6];
+		uint64 const Mask = 1ull << (Value & 63);
+		if (!(Word & Mask))
+		{
+			Word |= Mask;
+			++Chunk.Num;
+			++NumCodepoints;
+		}
+
+		return;
+	}
+
+	int32 const Position = Algo::LowerBound(Chunk.Values, Value);
+	if (Chunk.Values.IsValidIndex(Position) && Chunk.Values[Position] == Value)
+		return;
+
+	Chunk.Values.Insert(Value, Position);
+	++Chunk.Num;
+	++NumCodepoints;
+
+	if (Chunk.Num > MaxArrayValues)
+	{
+		ConvertToBitmap(Chunk);
+	}
+}
+
+bool FUnicodeBrowserCodepointSet::Contains(int32 const Codepoint) const
+{
+	int32 const ChunkIndex = Codepoint >> ChunkBits;
+	if (Codepoint < 0 || ChunkIndex >= Chunks.Num())
+		return false;
+
+	FChunk const& Chunk = Chunks[ChunkIndex];
+	uint16 const Value = static_cast<uint16>(Codepoint & (ChunkSize - 1));
+
+	if (Chunk.IsBitmap())
+	{
+		return (Chunk.Bits[Value >> 6] & 1ull << (Value & 63)) != 0;
+	}
+
+	return Algo::BinarySearch(Chunk.Values, Value) != INDEX_NONE;
+}
+
+void FUnicodeBrowserCodepointSet::Reset()
+{
+	Chunks.Reset();
+	NumCodepoints = 0;
+}
+
+void FUnicodeBrowserCodepointSet::Append(FUnicodeBrowserCodepointSet const& Other)
+{
+	Other.ForEach([this](int32 const Codepoint) { Add(Codepoint); });
+}
+
+bool FUnicodeBrowserCodepointSet::ContainsAnyInRange(int32 const First, int32 const Last) const
+{
+	bool bFound = false;
+	int32 const FirstChunk = FMath::Max(First, 0) >> ChunkBits;
+	int32 const LastChunk = FMath::Min(Last >> ChunkBits, Chunks.Num() - 1);
+
+	for (int32 ChunkIndex = FirstChunk; ChunkIndex <= LastChunk && !bFound; ++ChunkIndex)
+	{
+		FChunk const& Chunk = Chunks[ChunkIndex];
+		if (Chunk.Num == 0)
+			continue;
+
+		int32 const Base = ChunkIndex << ChunkBits;
+		int32 const Low = FMath::Max(First - Base, 0);
+		int32 const High = FMath::Min(Last - Base, ChunkSize - 1);
+
+		if (Chunk.IsBitmap())
+		{
+			for (int32 Word = Low >> 6; Word <= High >> 6 && !bFound; ++Word)
+			{
+				// mask out the bits outside of the range within the first and the last word
+				uint64 Bits = Chunk.Bits[Word];
+				if (Word == Low >> 6)
+				{
+					Bits &= ~0ull << (Low & 63);
+				}
+
+				if (Word == High >> 6 && (High & 63) != 63)
+				{
+					Bits &= (1ull << ((High & 63) + 1)) - 1;
+				}
+
+				bFound = Bits != 0;
+			}
+		}
+		else
+		{
+			int32 const Position = Algo::LowerBound(Chunk.Values, static_cast<uint16>(Low));
+			bFound = Position < Chunk.Values.Num() && Chunk.Values[Position] <= High;
+		}
+	}
+
+	return bFound;
+}
+
+SIZE_T FUnicodeBrowserCodepointSet::GetAllocatedSize() const
+{
+	SIZE_T Size = Chunks.GetAllocatedSize();
+	for (FChunk const& Chunk : Chunks)
+	{
+		Size += Chunk.Values.GetAllocatedSize() + Chunk.Bits.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+void FUnicodeBrowserCodepointSet::ConvertToBitmap(FChunk& Chunk)
+{
+	Chunk.Bits.SetNumZeroed(ChunkSize / 64);
+	for (uint16 const Value : Chunk.Values)
+	{
+		Chunk.Bits[Value >> 6] |= 1ull << (Value & 63);
+	}
+
+	Chunk.Values.Empty();
+}
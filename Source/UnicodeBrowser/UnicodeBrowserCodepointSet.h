@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Algo/BinarySearch.h"
+
+/**
+ * adaptive set of codepoints (roaring bitmap style)
+ * the codepoint space is split into chunks of 65536 codepoints, sparse chunks store a sorted array of the low 16 bits,
+ * dense chunks switch to a bitmap, lookups and ordered iteration never depend on the amount of other chunks
+ */
+class UNICODEBROWSER_API FUnicodeBrowserCodepointSet
+{
+public:
+	void Add(int32 Codepoint);
+	bool Contains(int32 Codepoint) const;
+
+	int32 Num() const { return NumCodepoints; }
+	bool IsEmpty() const { return NumCodepoints == 0; }
+	void Reset();
+
+	// union with the other set
+	void Append(FUnicodeBrowserCodepointSet const& Other);
+
+	// is any codepoint of the inclusive range part of the set
+	bool ContainsAnyInRange(int32 First, int32 Last) const;
+
+	// calls Func(Codepoint) for all codepoints within the inclusive range, in ascending order
+	template <typename FunctorType>
+	void ForEachInRange(int32 First, int32 Last, FunctorType&& Func) const;
+
+	template <typename FunctorType>
+	void ForEach(FunctorType&& Func) const
+	{
+		ForEachInRange(0, MAX_int32, Forward<FunctorType>(Func));
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static constexpr int32 ChunkBits = 16;
+	static constexpr int32 ChunkSize = 1 << ChunkBits;
+	static constexpr int32 MaxArrayValues = 4096; // above this a bitmap (8 KiB) is smaller than the array
+
+	struct FChunk
+	{
+		TArray<uint16> Values; // sorted, used while the chunk is sparse
+		TArray<uint64> Bits; // ChunkSize bits, used once the chunk is dense
+		int32 Num = 0;
+
+		bool IsBitmap() const { return !Bits.IsEmpty(); }
+	};
+
+	static void ConvertToBitmap(FChunk& Chunk);
+
+	TArray<FChunk> Chunks; // indexed by Codepoint >> ChunkBits
+	int32 NumCodepoints = 0;
+};
+
+template <typename FunctorType>
+void FUnicodeBrowserCodepointSet::ForEachInRange(int32 const First, int32 const Last, FunctorType&& Func) const
+{
+	int32 const FirstChunk = FMath::Max(First, 0) >> ChunkBits;
+	int32 const LastChunk = FMath::Min(Last >> ChunkBits, Chunks.Num() - 1);
+
+	for (int32 ChunkIndex = FirstChunk; ChunkIndex <= LastChunk; ++ChunkIndex)
+	{
+		FChunk const& Chunk = Chunks[ChunkIndex];
+		if (Chunk.Num == 0)
+			continue;
+
+		int32 const Base = ChunkIndex << ChunkBits;
+		int32 const Low = FMath::Max(First - Base, 0);
+		int32 const High = FMath::Min(Last - Base, ChunkSize - 1);
+
+		if (Chunk.IsBitmap())
+		{
+			for (int32 Word = Low >> 6; Word <= High >> 6; ++Word)
+			{
+				uint64 Bits = Chunk.Bits[Word];
+				while (Bits)
+				{
+					int32 const Value = Word << 6 | static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+					Bits &= Bits - 1;
+
+					if (Value >= Low && Value <= High)
+					{
+						Func(Base + Value);
+					}
+				}
+			}
+		}
+		else
+		{
+			int32 Position = Algo::LowerBound(Chunk.Values, static_cast<uint16>(Low));
+			for (; Position < Chunk.Values.Num() && Chunk.Values[Position] <= High; ++Position)
+			{
+				Func(Base + Chunk.Values[Position]);
+			}
+		}
+	}
+}
@@ -0,0 +1,464 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointTable.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+#include "UnicodeBrowser/UnicodeBrowserFontCoverage.h"
+#include "UnicodeBrowser/UnicodeBrowserGlyphCache.h"
+
+#include "Algo/BinarySearch.h"
+
+#include "Async/Async.h"
+
+#include "Fonts/FontCache.h"
+#include "Fonts/FontMeasure.h"
+
+#include "Framework/Application/SlateApplication.h"
+
+#include "Rendering/SlateRenderer.h"
+
+namespace UnicodeBrowser::CodepointTable
+{
+	// encodes a codepoint as UTF-16, returns false for codepoints which can't be represented as a character
+	bool EncodeUtf16(int32 const Codepoint, UTF16CHAR (&OutUnits)[2])
+	{
+		OutUnits[0] = 0;
+		OutUnits[1] = 0;
+
+		// surrogates and non-characters can't be converted to a string
+		if (Codepoint < 0 || Codepoint > 0x10FFFF || (Codepoint >= 0xD800 && Codepoint <= 0xDFFF) || Codepoint == 0xFFFE || Codepoint == 0xFFFF)
+			return false;
+
+		if (Codepoint >= 0x10000)
+		{
+			int32 const Offset = Codepoint - 0x10000;
+			OutUnits[0] = static_cast<UTF16CHAR>(0xD800 + (Offset >> 10));
+			OutUnits[1] = static_cast<UTF16CHAR>(0xDC00 + (Offset & 0x3FF));
+		}
+		else
+		{
+			OutUnits[0] = static_cast<UTF16CHAR>(Codepoint);
+		}
+
+		return true;
+	}
+}
+
+TSharedRef<FUnicodeBrowserCodepointTable> FUnicodeBrowserCodepointTable::Create(
+	FSlateFontInfo const& FontInfoIn,
+	TConstArrayView<FUnicodeBlockRange const> Ranges,
+	TSharedPtr<TBitArray<> const> CoverageIn,
+	uint64 const FontKeyIn,
+	FThreadSafeBool const* bCanceled
+)
+{
+	TSharedRef<FUnicodeBrowserCodepointTable> Table = MakeShared<FUnicodeBrowserCodepointTable>();
+	Table->FontInfo = FontInfoIn;
+	Table->FontKey = FontKeyIn;
+	Table->Coverage = CoverageIn.IsValid() ? CoverageIn : FUnicodeBrowserFontCoverage::GetFontCoverage(FontInfoIn, &Table->FontKey);
+	Table->Blocks.Reserve(Ranges.Num());
+
+	for (FUnicodeBlockRange const& Range : Ranges)
+	{
+		FBlock& Block = Table->Blocks.AddDefaulted_GetRef();
+		Block.Range = Range.Index;
+		Block.DisplayName = Range.GetDisplayName();
+		Block.FirstCodepoint = Range.GetRange().GetLowerBoundValue();
+		Block.Num = Range.GetRange().GetUpperBoundValue() - Block.FirstCodepoint + 1;
+	}
+
+	// keep the blocks ordered by codepoint, this allows a binary search in FindIndex
+	Table->Blocks.StableSort([](FBlock const& A, FBlock const& B) { return A.FirstCodepoint < B.FirstCodepoint; });
+
+	int32 Count = 0;
+	for (FBlock& Block : Table->Blocks)
+	{
+		Block.Offset = Count;
+		Count += Block.Num;
+	}
+
+	Table->BuildBlockLookup();
+
+	Table->Allocate(Count);
+
+	for (int32 BlockIndex = 0; BlockIndex < Table->Blocks.Num(); ++BlockIndex)
+	{
+		if (bCanceled && *bCanceled)
+			return Table;
+
+		FBlock const& Block = Table->Blocks[BlockIndex];
+		for (int32 Idx = 0; Idx < Block.Num; ++Idx)
+		{
+			Table->InitRow(Block.Offset + Idx, Block.FirstCodepoint + Idx, static_cast<uint16>(BlockIndex));
+		}
+	}
+
+	Table->CountCoverage();
+	Table->LoadCachedMetrics();
+
+	return Table;
+}
+
+TSharedRef<FUnicodeBrowserCodepointTable> FUnicodeBrowserCodepointTable::CreateSingle(FSlateFontInfo const& FontInfoIn, int32 const Codepoint, TOptional<EUnicodeBlockRange> const BlockRange)
+{
+	TSharedRef<FUnicodeBrowserCodepointTable> Table = MakeShared<FUnicodeBrowserCodepointTable>();
+	Table->FontInfo = FontInfoIn;
+	Table->Coverage = FUnicodeBrowserFontCoverage::GetFontCoverage(FontInfoIn);
+
+	if (BlockRange.IsSet())
+	{
+		FBlock& Block = Table->Blocks.AddDefaulted_GetRef();
+		Block.Range = BlockRange.GetValue();
+		Block.FirstCodepoint = Codepoint;
+		Block.Offset = 0;
+		Block.Num = 1;
+	}
+
+	Table->BuildBlockLookup();
+
+	Table->Allocate(1);
+	Table->InitRow(0, Codepoint, BlockRange.IsSet() ? 0 : MAX_uint16);
+	Table->CountCoverage();
+
+	return Table;
+}
+
+void FUnicodeBrowserCodepointTable::Allocate(int32 const Count)
+{
+	Handles.SetNumUninitialized(Count);
+	Codepoints.SetNumUninitialized(Count);
+	BlockIndices.SetNumUninitialized(Count);
+	Characters.SetNumUninitialized(Count * 2);
+
+	Flags.SetNumZeroed(Count);
+	FontData.SetNumZeroed(Count);
+	Measurements.SetNumZeroed(Count);
+	ScalingFactors.SetNumZeroed(Count);
+	CoveredMask.Init(false, Count);
+	NonZeroSizeMask.Init(false, Count);
+}
+
+void FUnicodeBrowserCodepointTable::CountCoverage()
+{
+	if (!Coverage.IsValid())
+		return;
+
+	for (FBlock& Block : Blocks)
+	{
+		// only visit the set bits, the iterator skips empty words of the bitmap
+		Block.NumCovered = 0;
+		for (TConstSetBitIterator<> It(*Coverage, Block.FirstCodepoint); It && It.GetIndex() < Block.FirstCodepoint + Block.Num; ++It)
+		{
+			CoveredMask[Block.Offset + It.GetIndex() - Block.FirstCodepoint] = true;
+			++Block.NumCovered;
+		}
+	}
+}
+
+void FUnicodeBrowserCodepointTable::BuildBlockLookup()
+{
+	int32 MaxRangeValue = -1;
+	for (FBlock const& Block : Blocks)
+	{
+		MaxRangeValue = FMath::Max(MaxRangeValue, static_cast<int32>(Block.Range));
+	}
+
+	BlockIndexByRange.Init(INDEX_NONE, MaxRangeValue + 1);
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		BlockIndexByRange[static_cast<int32>(Blocks[BlockIndex].Range)] = BlockIndex;
+	}
+}
+
+void FUnicodeBrowserCodepointTable::InitRow(int32 const Index, int32 const Codepoint, uint16 const BlockIndex)
+{
+	Handles[Index] = FUnicodeBrowserRow(this, Index);
+	Codepoints[Index] = Codepoint;
+	BlockIndices[Index] = BlockIndex;
+
+	UTF16CHAR Units[2];
+	bool const bValid = UnicodeBrowser::CodepointTable::EncodeUtf16(Codepoint, Units);
+	Characters[Index * 2] = Units[0];
+	Characters[Index * 2 + 1] = Units[1];
+
+	SetFlag(Index, ERowFlags::ValidCharacter, bValid);
+}
+
+FUnicodeBrowserCodepointTable::FBlock const* FUnicodeBrowserCodepointTable::FindBlock(EUnicodeBlockRange const BlockRange) const
+{
+	int32 const BlockIndex = FindBlockIndex(BlockRange);
+	return BlockIndex != INDEX_NONE ? &Blocks[BlockIndex] : nullptr;
+}
+
+int32 FUnicodeBrowserCodepointTable::FindBlockIndex(EUnicodeBlockRange const BlockRange) const
+{
+	int32 const RangeValue = static_cast<int32>(BlockRange);
+	return BlockIndexByRange.IsValidIndex(RangeValue) ? BlockIndexByRange[RangeValue] : INDEX_NONE;
+}
+
+int32 FUnicodeBrowserCodepointTable::FindIndex(int32 const Codepoint) const
+{
+	// blocks are ordered by codepoint, find the last block which starts before the codepoint
+	int32 const BlockIndex = Algo::UpperBoundBy(Blocks, Codepoint, &FBlock::FirstCodepoint) - 1;
+	if (!Blocks.IsValidIndex(BlockIndex))
+		return INDEX_NONE;
+
+	FBlock const& Block = Blocks[BlockIndex];
+	return Codepoint < Block.FirstCodepoint + Block.Num ? Block.Offset + Codepoint - Block.FirstCodepoint : INDEX_NONE;
+}
+
+void FUnicodeBrowserCodepointTable::SetRangeBits(TBitArray<>& Mask, TConstArrayView<FInt32Vector2> const CodepointRanges) const
+{
+	for (FInt32Vector2 const& Range : CodepointRanges)
+	{
+		int32 BlockIndex = FMath::Max(Algo::UpperBoundBy(Blocks, Range.X, &FBlock::FirstCodepoint) - 1, 0);
+		for (; BlockIndex < Blocks.Num() && Blocks[BlockIndex].FirstCodepoint <= Range.Y; ++BlockIndex)
+		{
+			FBlock const& Block = Blocks[BlockIndex];
+			int32 const First = FMath::Max(Range.X, Block.FirstCodepoint);
+			int32 const Last = FMath::Min(Range.Y, Block.FirstCodepoint + Block.Num - 1);
+			if (First <= Last)
+			{
+				Mask.SetRange(Block.Offset + First - Block.FirstCodepoint, Last - First + 1, true);
+			}
+		}
+	}
+}
+
+void FUnicodeBrowserCodepointTable::SetCodepointBits(TBitArray<>& Mask, FUnicodeBrowserCodepointSet const& Codepoints) const
+{
+	if (Codepoints.IsEmpty())
+		return;
+
+	for (FBlock const& Block : Blocks)
+	{
+		Codepoints.ForEachInRange(
+			Block.FirstCodepoint,
+			Block.FirstCodepoint + Block.Num - 1,
+			[&Mask, &Block](int32 const Codepoint)
+			{
+				Mask[Block.Offset + Codepoint - Block.FirstCodepoint] = true;
+			}
+		);
+	}
+}
+
+TSharedPtr<FUnicodeBrowserRow> FUnicodeBrowserCodepointTable::GetRow(int32 const Index)
+{
+	if (!IsValidIndex(Index))
+		return {};
+
+	// aliasing constructor, the row shares the reference counter of the table
+	return TSharedPtr<FUnicodeBrowserRow>(AsShared(), &Handles[Index]);
+}
+
+FString FUnicodeBrowserCodepointTable::GetCharacter(int32 const Index) const
+{
+	if (!HasValidCharacter(Index))
+		return FString();
+
+	UTF16CHAR const* Units = &Characters[Index * 2];
+	auto const Converted = StringCast<TCHAR>(Units, Units[1] ? 2 : 1);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+TOptional<EUnicodeBlockRange> FUnicodeBrowserCodepointTable::GetBlockRange(int32 const Index) const
+{
+	if (Blocks.IsValidIndex(BlockIndices[Index]))
+	{
+		return Blocks[BlockIndices[Index]].Range;
+	}
+
+	return {};
+}
+
+void FUnicodeBrowserCodepointTable::SetFontInfo(FSlateFontInfo const& FontInfoIn)
+{
+	FontInfo = FontInfoIn;
+}
+
+FFontData const* FUnicodeBrowserCodepointTable::GetFontData(int32 const Index) const
+{
+	if (!HasFlag(Index, ERowFlags::FontDataCached))
+	{
+		float ScalingFactorResult;
+		FontData[Index] = &FSlateApplication::Get().GetRenderer()->GetFontCache()->GetFontDataForCodepoint(FontInfo, Codepoints[Index], ScalingFactorResult);
+		ScalingFactors[Index] = ScalingFactorResult;
+		SetFlag(Index, ERowFlags::FontDataCached, true);
+	}
+
+	return FontData[Index];
+}
+
+FVector2D FUnicodeBrowserCodepointTable::GetMeasurements(int32 const Index) const
+{
+	if (!HasFlag(Index, ERowFlags::MeasurementsCached) && FontInfo.Size > 0.0f)
+	{
+		FVector2D const Measured = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(GetCharacter(Index), FontInfo);
+		StoreMeasurement(Index, FVector2f(Measured / FontInfo.Size));
+		bMetricsDirty = true;
+	}
+
+	return FVector2D(Measurements[Index] * FontInfo.Size);
+}
+
+void FUnicodeBrowserCodepointTable::StoreMeasurement(int32 const Index, FVector2f const NormalizedMeasurement) const
+{
+	Measurements[Index] = NormalizedMeasurement;
+	NonZeroSizeMask[Index] = !NormalizedMeasurement.IsZero();
+	SetFlag(Index, ERowFlags::MeasurementsCached, true);
+}
+
+void FUnicodeBrowserCodepointTable::EvaluateSizes(TBitArray<> const& Candidates, int32 const StartIndex, int32 const EndIndex) const
+{
+	for (TConstSetBitIterator<> It(Candidates, StartIndex); It && It.GetIndex() < EndIndex; ++It)
+	{
+		if (!HasFlag(It.GetIndex(), ERowFlags::MeasurementsCached))
+		{
+			// ReSharper disable once CppExpressionWithoutSideEffects
+			GetMeasurements(It.GetIndex());
+		}
+	}
+}
+
+float FUnicodeBrowserCodepointTable::GetScaling(int32 const Index) const
+{
+	// this will populate the ScalingFactor
+	// ReSharper disable once CppExpressionWithoutSideEffects
+	GetFontData(Index);
+	return ScalingFactors[Index];
+}
+
+void FUnicodeBrowserCodepointTable::Preload(int32 const Index) const
+{
+	// ReSharper disable once CppExpressionWithoutSideEffects
+	GetFontData(Index);
+	// ReSharper disable once CppExpressionWithoutSideEffects
+	GetMeasurements(Index);
+}
+
+void FUnicodeBrowserCodepointTable::PreloadAll() const
+{
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		Preload(Index);
+	}
+}
+
+SIZE_T FUnicodeBrowserCodepointTable::GetAllocatedSize() const
+{
+	return Blocks.GetAllocatedSize()
+		+ BlockIndexByRange.GetAllocatedSize()
+		+ Handles.GetAllocatedSize()
+		+ Codepoints.GetAllocatedSize()
+		+ BlockIndices.GetAllocatedSize()
+		+ Characters.GetAllocatedSize()
+		+ Flags.GetAllocatedSize()
+		+ FontData.GetAllocatedSize()
+		+ Measurements.GetAllocatedSize()
+		+ ScalingFactors.GetAllocatedSize()
+		+ CoveredMask.GetAllocatedSize()
+		+ NonZeroSizeMask.GetAllocatedSize();
+}
+
+void FUnicodeBrowserCodepointTable::LoadCachedMetrics()
+{
+	if (FontKey == 0)
+		return;
+
+	int32 NumApplied = 0;
+	FUnicodeBrowserGlyphCache::LoadMetrics(
+		FontKey,
+		[this, &NumApplied](int32 const Codepoint, FVector2f const NormalizedMeasurement)
+		{
+			int32 const Index = FindIndex(Codepoint);
+			if (Index != INDEX_NONE)
+			{
+				StoreMeasurement(Index, NormalizedMeasurement);
+				++NumApplied;
+			}
+		}
+	);
+
+	UE_LOG(LogTemp, Verbose, TEXT("[FUnicodeBrowserCodepointTable] Loaded %d cached glyph metrics for font %016llx"), NumApplied, FontKey);
+}
+
+void FUnicodeBrowserCodepointTable::SaveCachedMetrics() const
+{
+	if (FontKey == 0 || !bMetricsDirty)
+		return;
+
+	TArray<int32> CachedCodepoints;
+	TArray<FVector2f> CachedMeasurements;
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if (HasFlag(Index, ERowFlags::MeasurementsCached))
+		{
+			CachedCodepoints.Add(Codepoints[Index]);
+			CachedMeasurements.Add(Measurements[Index]);
+		}
+	}
+
+	bMetricsDirty = false;
+
+	Async(
+		EAsyncExecution::ThreadPool,
+		[FontKey = FontKey, CachedCodepoints = MoveTemp(CachedCodepoints), CachedMeasurements = MoveTemp(CachedMeasurements)]()
+		{
+			FUnicodeBrowserGlyphCache::SaveMetrics(FontKey, CachedCodepoints, CachedMeasurements);
+		}
+	);
+}
+
+int32 FUnicodeBrowserRow::GetCodepoint() const
+{
+	return Table ? Table->GetCodepoint(Index) : -1;
+}
+
+FString FUnicodeBrowserRow::GetCharacter() const
+{
+	return Table ? Table->GetCharacter(Index) : FString();
+}
+
+bool FUnicodeBrowserRow::HasValidCharacter() const
+{
+	return Table && Table->HasValidCharacter(Index);
+}
+
+TOptional<EUnicodeBlockRange> FUnicodeBrowserRow::GetBlockRange() const
+{
+	return Table ? Table->GetBlockRange(Index) : TOptional<EUnicodeBlockRange>();
+}
+
+FSlateFontInfo const* FUnicodeBrowserRow::GetFontInfo() const
+{
+	return Table ? &Table->GetFontInfo() : nullptr;
+}
+
+FFontData const* FUnicodeBrowserRow::GetFontData() const
+{
+	return Table ? Table->GetFontData(Index) : nullptr;
+}
+
+bool FUnicodeBrowserRow::CanLoadCodepoint() const
+{
+	return Table && Table->CanLoadCodepoint(Index);
+}
+
+FVector2D FUnicodeBrowserRow::GetMeasurements() const
+{
+	return Table ? Table->GetMeasurements(Index) : FVector2D::ZeroVector;
+}
+
+float FUnicodeBrowserRow::GetScaling() const
+{
+	return Table ? Table->GetScaling(Index) : 0.0f;
+}
+
+void FUnicodeBrowserRow::Preload() const
+{
+	if (Table)
+	{
+		Table->Preload(Index);
+	}
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Fonts/SlateFontInfo.h"
+#include "Fonts/UnicodeBlockRange.h"
+
+#include "HAL/ThreadSafeBool.h"
+
+#include "UnicodeBrowser/UnicodeBrowserRow.h"
+
+class FUnicodeBrowserCodepointSet;
+struct FFontData;
+
+/**
+ * flat, index addressed storage of all codepoints of a font
+ * every codepoint lives at an index, the data is kept in packed arrays (structure of arrays) and the
+ * tile view only references lightweight FUnicodeBrowserRow handles which share the reference count of the table
+ * tables are shared between all browsers (see UUnicodeBrowserFontDataSubsystem), view state like filters lives in the browser
+ */
+class UNICODEBROWSER_API FUnicodeBrowserCodepointTable : public TSharedFromThis<FUnicodeBrowserCodepointTable>
+{
+public:
+	enum class ERowFlags : uint8
+	{
+		None = 0,
+		ValidCharacter = 1 << 0,
+		FontDataCached = 1 << 1,
+		MeasurementsCached = 1 << 2
+	};
+
+	// a contiguous slice of the table which belongs to a single Unicode block
+	struct FBlock
+	{
+		EUnicodeBlockRange Range;
+		FText DisplayName;
+		int32 FirstCodepoint = 0;
+		int32 Offset = 0; // index of the first codepoint within the table
+		int32 Num = 0;
+		int32 NumCovered = 0; // amount of codepoints which are supported by the font
+	};
+
+	// creates a table with all codepoints of the given ranges, this performs a single allocation per array
+	// the table can be created on any thread if the coverage is provided, otherwise it's resolved from the font info
+	// FontKeyIn identifies the font for the on-disk glyph cache (see FUnicodeBrowserFontCoverage::GetFontCoverage), 0 disables the cache
+	// once bCanceled is set the rows of the remaining blocks are skipped, the incomplete table must be discarded
+	static TSharedRef<FUnicodeBrowserCodepointTable> Create(
+		FSlateFontInfo const& FontInfoIn,
+		TConstArrayView<FUnicodeBlockRange const> Ranges,
+		TSharedPtr<TBitArray<> const> CoverageIn = nullptr,
+		uint64 FontKeyIn = 0,
+		FThreadSafeBool const* bCanceled = nullptr
+	);
+
+	// creates a table which only holds a single codepoint, e.g. as a placeholder for the preview
+	static TSharedRef<FUnicodeBrowserCodepointTable> CreateSingle(FSlateFontInfo const& FontInfoIn, int32 Codepoint, TOptional<EUnicodeBlockRange> BlockRange);
+
+	int32 Num() const { return Codepoints.Num(); }
+	bool IsValidIndex(int32 const Index) const { return Codepoints.IsValidIndex(Index); }
+
+	TConstArrayView<FBlock> GetBlocks() const { return Blocks; }
+	// constant time lookups through a table indexed by the value of EUnicodeBlockRange
+	FBlock const* FindBlock(EUnicodeBlockRange BlockRange) const;
+	int32 FindBlockIndex(EUnicodeBlockRange BlockRange) const;
+
+	// returns the table index of a codepoint or INDEX_NONE if the codepoint isn't part of the table
+	int32 FindIndex(int32 Codepoint) const;
+
+	// sets the bits of all indices whose codepoint lies within any of the inclusive codepoint ranges
+	// every range maps to one contiguous slice per block which it overlaps, nothing is visited codepoint by codepoint
+	void SetRangeBits(TBitArray<>& Mask, TConstArrayView<FInt32Vector2> CodepointRanges) const;
+
+	// sets the bits of all indices whose codepoint is part of the set, the set is only visited within the blocks
+	void SetCodepointBits(TBitArray<>& Mask, FUnicodeBrowserCodepointSet const& Codepoints) const;
+
+	// returns a handle to the row at the given index, the handle keeps the table alive
+	TSharedPtr<FUnicodeBrowserRow> GetRow(int32 Index);
+
+	FSlateFontInfo const& GetFontInfo() const { return FontInfo; }
+
+	// update the font style (e.g. size), measurements are stored normalized to the font size and stay valid
+	void SetFontInfo(FSlateFontInfo const& FontInfoIn);
+
+	int32 GetCodepoint(int32 const Index) const { return Codepoints[Index]; }
+	FString GetCharacter(int32 Index) const;
+	bool HasValidCharacter(int32 const Index) const { return HasFlag(Index, ERowFlags::ValidCharacter); }
+	TOptional<EUnicodeBlockRange> GetBlockRange(int32 Index) const;
+	int32 GetBlockIndex(int32 const Index) const { return BlockIndices[Index]; }
+
+	// coverage bitmap of the font, one bit per codepoint, only valid for tables made by Create or CreateSingle
+	TBitArray<> const& GetCoverage() const { return *Coverage; }
+
+	// the coverage in table space, one bit per index, set if the font supports the codepoint
+	TBitArray<> const& GetCoveredMask() const { return CoveredMask; }
+
+	// one bit per index, set if the codepoint was measured with a size other than 0x0
+	// only indices which were evaluated (see EvaluateSizes) are reliable
+	TBitArray<> const& GetNonZeroSizeMask() const { return NonZeroSizeMask; }
+
+	// measures all candidates within [StartIndex, EndIndex) which weren't measured yet
+	void EvaluateSizes(TBitArray<> const& Candidates, int32 StartIndex, int32 EndIndex) const;
+
+	FFontData const* GetFontData(int32 Index) const;
+	bool CanLoadCodepoint(int32 const Index) const { return Coverage.IsValid() && (*Coverage)[Codepoints[Index]]; }
+	FVector2D GetMeasurements(int32 Index) const;
+	float GetScaling(int32 Index) const;
+
+	// preload cached data of a single row
+	void Preload(int32 Index) const;
+
+	// preload cached data of all rows
+	void PreloadAll() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	// reads previously measured glyphs of this font from the on-disk glyph cache
+	void LoadCachedMetrics();
+
+	// writes all measured glyphs to the on-disk glyph cache, the file is written on a background thread
+	void SaveCachedMetrics() const;
+
+protected:
+	bool HasFlag(int32 const Index, ERowFlags const Flag) const { return (Flags[Index] & static_cast<uint8>(Flag)) != 0; }
+	void SetFlag(int32 const Index, ERowFlags const Flag, bool const bValue) const
+	{
+		if (bValue)
+		{
+			Flags[Index] |= static_cast<uint8>(Flag);
+		}
+		else
+		{
+			Flags[Index] &= ~static_cast<uint8>(Flag);
+		}
+	}
+
+	void Allocate(int32 Count);
+	void CountCoverage();
+	void BuildBlockLookup();
+	void InitRow(int32 Index, int32 Codepoint, uint16 BlockIndex);
+	void StoreMeasurement(int32 Index, FVector2f NormalizedMeasurement) const;
+
+	FSlateFontInfo FontInfo;
+	uint64 FontKey = 0;
+	mutable bool bMetricsDirty = false; // measurements which aren't part of the on-disk cache yet
+	TSharedPtr<TBitArray<> const> Coverage; // shared with FUnicodeBrowserFontCoverage, assigned by the factories
+
+	TArray<FBlock> Blocks;
+	TArray<int32> BlockIndexByRange; // EUnicodeBlockRange => index into Blocks
+	TArray<FUnicodeBrowserRow> Handles;
+
+	TArray<int32> Codepoints;
+	TArray<uint16> BlockIndices; // index into Blocks, MAX_uint16 if the codepoint isn't part of a block
+	TArray<UTF16CHAR> Characters; // inline UTF-16 storage, two code units per codepoint, the second one is 0 for the BMP
+	TBitArray<> CoveredMask;
+
+	// lazily evaluated data
+	mutable TArray<uint8> Flags;
+	mutable TArray<FFontData const*> FontData;
+	mutable TArray<FVector2f> Measurements; // normalized to a font size of 1
+	mutable TArray<float> ScalingFactors;
+	mutable TBitArray<> NonZeroSizeMask;
+};
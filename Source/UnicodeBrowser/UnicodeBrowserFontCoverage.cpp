@@ -0,0 +1,432 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserFontCoverage.h"
+
+#include "Fonts/FontCache.h"
+#include "Fonts/SlateFontInfo.h"
+
+#include "Framework/Application/SlateApplication.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+#include "Rendering/SlateRenderer.h"
+
+#include "UnicodeBrowser/UnicodeBrowserGlyphCache.h"
+#include "UnicodeBrowser/UnicodeBrowserStatic.h"
+
+FCriticalSection FUnicodeBrowserFontCoverage::CacheLock;
+TMap<FFontData, FUnicodeBrowserFontCoverage::FFaceEntry> FUnicodeBrowserFontCoverage::FaceCache;
+
+namespace UnicodeBrowser::FontCoverage
+{
+	// all values within the font file are stored big endian, reads are bounds checked against the whole file
+	struct FFontReader
+	{
+		TConstArrayView<uint8> Bytes;
+
+		bool IsValidRange(int64 const Offset, int64 const Size) const
+		{
+			return Offset >= 0 && Size >= 0 && Offset + Size <= Bytes.Num();
+		}
+
+		uint16 U16(int64 const Offset) const
+		{
+			return IsValidRange(Offset, 2) ? static_cast<uint16>(Bytes[Offset] << 8 | Bytes[Offset + 1]) : 0;
+		}
+
+		uint32 U32(int64 const Offset) const
+		{
+			return IsValidRange(Offset, 4) ? static_cast<uint32>(Bytes[Offset]) << 24 | static_cast<uint32>(Bytes[Offset + 1]) << 16 | static_cast<uint32>(Bytes[Offset + 2]) << 8 | Bytes[Offset + 3] : 0;
+		}
+	};
+
+	uint32 constexpr MakeTag(char const A, char const B, char const C, char const D)
+	{
+		return static_cast<uint32>(A) << 24 | static_cast<uint32>(B) << 16 | static_cast<uint32>(C) << 8 | static_cast<uint32>(D);
+	}
+
+	void SetCodepoint(TBitArray<>& Coverage, int64 const Codepoint)
+	{
+		if (Codepoint >= 0 && Codepoint < FUnicodeBrowserFontCoverage::NumCodepoints)
+		{
+			Coverage[static_cast<int32>(Codepoint)] = true;
+		}
+	}
+
+	void SetCodepointRange(TBitArray<>& Coverage, int64 const First, int64 const Last)
+	{
+		int64 const ClampedFirst = FMath::Max<int64>(First, 0);
+		int64 const ClampedLast = FMath::Min<int64>(Last, FUnicodeBrowserFontCoverage::NumCodepoints - 1);
+		if (ClampedFirst <= ClampedLast)
+		{
+			Coverage.SetRange(static_cast<int32>(ClampedFirst), static_cast<int32>(ClampedLast - ClampedFirst + 1), true);
+		}
+	}
+
+	// segment mapping to delta values, the common subtable for the BMP
+	void ParseFormat4(FFontReader const& Reader, int64 const Table, TBitArray<>& Coverage)
+	{
+		int32 const SegCount = Reader.U16(Table + 6) / 2;
+		int64 const EndCodes = Table + 14;
+		int64 const StartCodes = EndCodes + SegCount * 2 + 2; // + reservedPad
+		int64 const IdDeltas = StartCodes + SegCount * 2;
+		int64 const IdRangeOffsets = IdDeltas + SegCount * 2;
+
+		if (!Reader.IsValidRange(EndCodes, SegCount * 8 + 2))
+			return;
+
+		for (int32 Segment = 0; Segment < SegCount; ++Segment)
+		{
+			uint32 const EndCode = Reader.U16(EndCodes + Segment * 2);
+			uint32 const StartCode = Reader.U16(StartCodes + Segment * 2);
+			uint16 const IdDelta = Reader.U16(IdDeltas + Segment * 2);
+			int64 const IdRangeOffsetPosition = IdRangeOffsets + Segment * 2;
+			uint16 const IdRangeOffset = Reader.U16(IdRangeOffsetPosition);
+
+			for (uint32 Codepoint = StartCode; Codepoint <= EndCode && Codepoint != 0xFFFF; ++Codepoint)
+			{
+				uint16 Glyph;
+				if (IdRangeOffset == 0)
+				{
+					Glyph = static_cast<uint16>(Codepoint + IdDelta);
+				}
+				else
+				{
+					uint16 const GlyphIndex = Reader.U16(IdRangeOffsetPosition + IdRangeOffset + (Codepoint - StartCode) * 2);
+					Glyph = GlyphIndex ? static_cast<uint16>(GlyphIndex + IdDelta) : 0;
+				}
+
+				if (Glyph != 0)
+				{
+					SetCodepoint(Coverage, Codepoint);
+				}
+			}
+		}
+	}
+
+	// segmented coverage (12) and many-to-one range mappings (13), used for codepoints beyond the BMP
+	void ParseFormat12Or13(FFontReader const& Reader, int64 const Table, bool const bConstantGlyph, TBitArray<>& Coverage)
+	{
+		uint32 const NumGroups = Reader.U32(Table + 12);
+		int64 const Groups = Table + 16;
+
+		if (!Reader.IsValidRange(Groups, static_cast<int64>(NumGroups) * 12))
+			return;
+
+		for (uint32 Group = 0; Group < NumGroups; ++Group)
+		{
+			int64 const GroupOffset = Groups + static_cast<int64>(Group) * 12;
+			uint32 const StartChar = Reader.U32(GroupOffset);
+			uint32 const EndChar = Reader.U32(GroupOffset + 4);
+			uint32 const StartGlyph = Reader.U32(GroupOffset + 8);
+
+			if (EndChar < StartChar)
+				continue;
+
+			if (StartGlyph != 0)
+			{
+				SetCodepointRange(Coverage, StartChar, EndChar);
+			}
+			else if (!bConstantGlyph)
+			{
+				// only the first character maps to .notdef
+				SetCodepointRange(Coverage, static_cast<int64>(StartChar) + 1, EndChar);
+			}
+		}
+	}
+
+	// byte encoding table
+	void ParseFormat0(FFontReader const& Reader, int64 const Table, TBitArray<>& Coverage)
+	{
+		for (int32 Codepoint = 0; Codepoint < 256; ++Codepoint)
+		{
+			if (Reader.IsValidRange(Table + 6 + Codepoint, 1) && Reader.Bytes[Table + 6 + Codepoint] != 0)
+			{
+				SetCodepoint(Coverage, Codepoint);
+			}
+		}
+	}
+
+	// trimmed table mapping
+	void ParseFormat6(FFontReader const& Reader, int64 const Table, TBitArray<>& Coverage)
+	{
+		uint32 const FirstCode = Reader.U16(Table + 6);
+		uint32 const EntryCount = Reader.U16(Table + 8);
+
+		for (uint32 Entry = 0; Entry < EntryCount; ++Entry)
+		{
+			if (Reader.U16(Table + 10 + Entry * 2) != 0)
+			{
+				SetCodepoint(Coverage, FirstCode + Entry);
+			}
+		}
+	}
+
+	bool ParseSubtable(FFontReader const& Reader, int64 const Table, TBitArray<>& Coverage)
+	{
+		switch (Reader.U16(Table))
+		{
+		case 0:
+			ParseFormat0(Reader, Table, Coverage);
+			return true;
+		case 4:
+			ParseFormat4(Reader, Table, Coverage);
+			return true;
+		case 6:
+			ParseFormat6(Reader, Table, Coverage);
+			return true;
+		case 12:
+			ParseFormat12Or13(Reader, Table, false, Coverage);
+			return true;
+		case 13:
+			ParseFormat12Or13(Reader, Table, true, Coverage);
+			return true;
+		default:
+			// formats 2, 8, 10 (legacy CJK encodings) and 14 (variation sequences) don't map Unicode codepoints
+			return false;
+		}
+	}
+
+	FTypefaceEntry const* FindTypefaceEntry(FTypeface const& Typeface, FName const TypefaceFontName)
+	{
+		if (FTypefaceEntry const* Entry = Typeface.Fonts.FindByPredicate([TypefaceFontName](FTypefaceEntry const& Candidate) { return Candidate.Name == TypefaceFontName; }))
+		{
+			return Entry;
+		}
+
+		return Typeface.Fonts.Num() > 0 ? &Typeface.Fonts[0] : nullptr;
+	}
+
+	void CombineTypeface(TBitArray<>& Coverage, uint64& FontKey, bool& bComplete, FTypeface const& Typeface, FName const TypefaceFontName, TBitArray<> const* Mask = nullptr)
+	{
+		FTypefaceEntry const* Entry = FindTypefaceEntry(Typeface, TypefaceFontName);
+		if (!Entry)
+			return;
+
+		uint64 FaceHash = 0;
+		bool bFaceComplete = true;
+		TSharedRef<TBitArray<> const> FaceCoverage = FUnicodeBrowserFontCoverage::GetFaceCoverage(Entry->Font, &FaceHash, &bFaceComplete);
+		FontKey = FUnicodeBrowserGlyphCache::CombineKey(FontKey, FaceHash);
+		bComplete &= bFaceComplete;
+
+		if (Mask)
+		{
+			Coverage.CombineWithBitwiseOR(TBitArray<>::BitwiseAND(*FaceCoverage, *Mask, EBitwiseOperatorFlags::MinSize), EBitwiseOperatorFlags::MaxSize);
+		}
+		else
+		{
+			Coverage.CombineWithBitwiseOR(*FaceCoverage, EBitwiseOperatorFlags::MaxSize);
+		}
+	}
+}
+
+using namespace UnicodeBrowser::FontCoverage;
+
+TSharedRef<TBitArray<> const> FUnicodeBrowserFontCoverage::GetFaceCoverage(FFontData const& FontData, uint64* OutContentHash, bool* bOutComplete)
+{
+	FFaceEntry const Entry = FindOrAddFace(FontData);
+	if (OutContentHash)
+	{
+		*OutContentHash = Entry.ContentHash;
+	}
+
+	if (bOutComplete)
+	{
+		*bOutComplete = Entry.bComplete;
+	}
+
+	return Entry.Coverage;
+}
+
+uint64 FUnicodeBrowserFontCoverage::GetFaceHash(FFontData const& FontData)
+{
+	return FindOrAddFace(FontData).ContentHash;
+}
+
+FUnicodeBrowserFontCoverage::FFaceEntry FUnicodeBrowserFontCoverage::FindOrAddFace(FFontData const& FontData)
+{
+	{
+		FScopeLock Lock(&CacheLock);
+		if (FFaceEntry const* Cached = FaceCache.Find(FontData))
+		{
+			return *Cached;
+		}
+	}
+
+	TSharedRef<TBitArray<>> Coverage = MakeShared<TBitArray<>>(false, NumCodepoints);
+	int32 const SubFaceIndex = FontData.GetSubFaceIndex();
+
+	TArray<uint8> FontBytes;
+	bool const bLoaded = LoadFontBytes(FontData, FontBytes);
+	uint64 const ContentHash = bLoaded ? FUnicodeBrowserGlyphCache::HashFontBytes(FontBytes) : 0;
+
+	// the on-disk cache is keyed by the content of the font file, so renamed or moved fonts still hit the cache
+	bool const bCached = bLoaded && FUnicodeBrowserGlyphCache::LoadCoverage(ContentHash, SubFaceIndex, *Coverage) && Coverage->Num() == NumCodepoints;
+	if (!bCached)
+	{
+		Coverage->Init(false, NumCodepoints);
+
+		if (bLoaded && ParseCmap(FontBytes, SubFaceIndex, *Coverage))
+		{
+			FUnicodeBrowserGlyphCache::SaveCoverage(ContentHash, SubFaceIndex, *Coverage);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[FUnicodeBrowserFontCoverage] Unable to read the cmap of font %s"), *FontData.GetFontFilename());
+
+			// fall back to probing the font cache, this is slow but only happens for fonts we can't parse
+			// the font cache is only available on the game thread, a worker leaves the face to the game thread instead of caching an empty bitmap
+			if (!IsInGameThread())
+				return FFaceEntry{Coverage, ContentHash, false};
+
+			if (FSlateApplication::IsInitialized())
+			{
+				TSharedRef<FSlateFontCache> const FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+				for (FUnicodeBlockRange const& Range : UnicodeBrowser::GetUnicodeBlockRanges())
+				{
+					for (int32 Codepoint = Range.GetRange().GetLowerBoundValue(); Codepoint <= Range.GetRange().GetUpperBoundValue(); ++Codepoint)
+					{
+						(*Coverage)[Codepoint] = FontCache->CanLoadCodepoint(FontData, Codepoint);
+					}
+				}
+			}
+		}
+	}
+
+	FScopeLock Lock(&CacheLock);
+	return FaceCache.Add(FontData, FFaceEntry{Coverage, ContentHash});
+}
+
+TSharedRef<TBitArray<> const> FUnicodeBrowserFontCoverage::GetFontCoverage(FSlateFontInfo const& FontInfo, uint64* OutFontKey)
+{
+	if (FCompositeFont const* CompositeFont = FontInfo.GetCompositeFont())
+	{
+		return GetFontCoverage(*CompositeFont, FontInfo.TypefaceFontName, OutFontKey);
+	}
+
+	if (OutFontKey)
+	{
+		*OutFontKey = 0;
+	}
+
+	return MakeShared<TBitArray<>>(false, NumCodepoints);
+}
+
+TSharedRef<TBitArray<> const> FUnicodeBrowserFontCoverage::GetFontCoverage(FCompositeFont const& CompositeFont, FName const TypefaceFontName, uint64* OutFontKey, bool* bOutComplete)
+{
+	TSharedRef<TBitArray<>> Coverage = MakeShared<TBitArray<>>(false, NumCodepoints);
+	uint64 FontKey = FUnicodeBrowserGlyphCache::CombineKey(FUnicodeBrowserGlyphCache::Version, TypefaceFontName);
+	bool bComplete = true;
+
+	// Slate resolves a codepoint to the first font of the chain which supports it (sub font => default typeface => fallback typeface)
+	// a codepoint is therefore supported if any font of the chain supports it, the sub fonts only apply to their character ranges
+	CombineTypeface(*Coverage, FontKey, bComplete, CompositeFont.DefaultTypeface, TypefaceFontName);
+	CombineTypeface(*Coverage, FontKey, bComplete, CompositeFont.FallbackTypeface.Typeface, TypefaceFontName);
+
+	for (FCompositeSubFont const& SubFont : CompositeFont.SubTypefaces)
+	{
+		TBitArray<> Mask(false, NumCodepoints);
+		for (FInt32Range const& Range : SubFont.CharacterRanges)
+		{
+			int64 const First = Range.HasLowerBound() ? Range.GetLowerBoundValue() + (Range.GetLowerBound().IsExclusive() ? 1 : 0) : 0;
+			int64 const Last = Range.HasUpperBound() ? Range.GetUpperBoundValue() - (Range.GetUpperBound().IsExclusive() ? 1 : 0) : NumCodepoints - 1;
+			SetCodepointRange(Mask, First, Last);
+		}
+
+		// the cultures of the sub fonts are ignored, the browser shows what's reachable for any culture
+		CombineTypeface(*Coverage, FontKey, bComplete, SubFont.Typeface, TypefaceFontName, &Mask);
+	}
+
+	if (OutFontKey)
+	{
+		*OutFontKey = FontKey;
+	}
+
+	if (bOutComplete)
+	{
+		*bOutComplete = bComplete;
+	}
+
+	return Coverage;
+}
+
+bool FUnicodeBrowserFontCoverage::ParseCmap(TConstArrayView<uint8> const FontBytes, int32 const SubFaceIndex, TBitArray<>& OutCoverage)
+{
+	FFontReader const Reader{FontBytes};
+
+	// font collections reference the offset table of each face
+	int64 OffsetTable = 0;
+	if (Reader.U32(0) == MakeTag('t', 't', 'c', 'f'))
+	{
+		uint32 const NumFonts = Reader.U32(8);
+		if (SubFaceIndex < 0 || static_cast<uint32>(SubFaceIndex) >= NumFonts)
+			return false;
+
+		OffsetTable = Reader.U32(12 + SubFaceIndex * 4);
+	}
+
+	// find the cmap table in the table directory
+	int64 Cmap = -1;
+	uint16 const NumTables = Reader.U16(OffsetTable + 4);
+	for (uint16 TableIndex = 0; TableIndex < NumTables; ++TableIndex)
+	{
+		int64 const Record = OffsetTable + 12 + TableIndex * 16;
+		if (Reader.U32(Record) == MakeTag('c', 'm', 'a', 'p'))
+		{
+			Cmap = Reader.U32(Record + 8);
+			break;
+		}
+	}
+
+	if (Cmap < 0 || !Reader.IsValidRange(Cmap, 4))
+		return false;
+
+	// merge all Unicode subtables, fonts commonly ship a BMP (format 4) and a full repertoire (format 12) table
+	bool bFoundUnicodeTable = false;
+	int64 SymbolTable = -1;
+	uint16 const NumSubtables = Reader.U16(Cmap + 2);
+	for (uint16 SubtableIndex = 0; SubtableIndex < NumSubtables; ++SubtableIndex)
+	{
+		int64 const Record = Cmap + 4 + SubtableIndex * 8;
+		uint16 const PlatformID = Reader.U16(Record);
+		uint16 const EncodingID = Reader.U16(Record + 2);
+		int64 const Subtable = Cmap + Reader.U32(Record + 4);
+
+		bool const bIsUnicode = (PlatformID == 0 && EncodingID != 5) || (PlatformID == 3 && (EncodingID == 1 || EncodingID == 10));
+		if (bIsUnicode)
+		{
+			bFoundUnicodeTable |= ParseSubtable(Reader, Subtable, OutCoverage);
+		}
+		else if (PlatformID == 3 && EncodingID == 0)
+		{
+			SymbolTable = Subtable;
+		}
+	}
+
+	// symbol fonts only provide a symbol table, their glyphs are mapped into the private use area
+	if (!bFoundUnicodeTable && SymbolTable >= 0)
+	{
+		bFoundUnicodeTable = ParseSubtable(Reader, SymbolTable, OutCoverage);
+	}
+
+	return bFoundUnicodeTable;
+}
+
+bool FUnicodeBrowserFontCoverage::LoadFontBytes(FFontData const& FontData, TArray<uint8>& OutBytes)
+{
+	if (FFontFaceDataConstPtr const FontFaceData = FontData.GetFontFaceData(); FontFaceData.IsValid() && FontFaceData->HasData())
+	{
+		OutBytes = FontFaceData->GetData();
+		return true;
+	}
+
+	// streamed fonts only reference the file on disk
+	return !FontData.GetFontFilename().IsEmpty() && FFileHelper::LoadFileToArray(OutBytes, *FontData.GetFontFilename(), FILEREAD_Silent);
+}
+
+void FUnicodeBrowserFontCoverage::ClearCache()
+{
+	FScopeLock Lock(&CacheLock);
+	FaceCache.Reset();
+}
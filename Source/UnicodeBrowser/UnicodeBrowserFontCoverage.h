@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Fonts/CompositeFont.h"
+
+struct FSlateFontInfo;
+
+/**
+ * codepoint coverage of fonts, based on the cmap table of each font face
+ * every face is parsed once and cached as a bitmap with one bit per codepoint (0 - 0x10FFFF),
+ * the coverage of a composite font is resolved by combining the bitmaps of its typefaces
+ * bitmaps are persisted in the FUnicodeBrowserGlyphCache, keyed by the content hash of the font file
+ */
+class UNICODEBROWSER_API FUnicodeBrowserFontCoverage
+{
+public:
+	static constexpr int32 NumCodepoints = 0x110000;
+
+	// coverage of a single font face
+	// faces without a readable cmap are probed through the Slate font cache, which only works on the game thread,
+	// on other threads bOutComplete is false for them and they aren't cached, so the game thread can resolve them later
+	static TSharedRef<TBitArray<> const> GetFaceCoverage(FFontData const& FontData, uint64* OutContentHash = nullptr, bool* bOutComplete = nullptr);
+
+	// content hash of the font file of a face, 0 if the file can't be read
+	static uint64 GetFaceHash(FFontData const& FontData);
+
+	// coverage of the composite font (default typeface, sub fonts and fallback) referenced by the font info
+	// OutFontKey identifies the contents of all faces and the typeface, it's used as key for cached glyph metrics
+	static TSharedRef<TBitArray<> const> GetFontCoverage(FSlateFontInfo const& FontInfo, uint64* OutFontKey = nullptr);
+	static TSharedRef<TBitArray<> const> GetFontCoverage(FCompositeFont const& CompositeFont, FName TypefaceFontName, uint64* OutFontKey = nullptr, bool* bOutComplete = nullptr);
+
+	// reads all codepoints which are mapped to a glyph from the cmap table of a TrueType/OpenType font (or a face of a collection)
+	static bool ParseCmap(TConstArrayView<uint8> FontBytes, int32 SubFaceIndex, TBitArray<>& OutCoverage);
+
+	// the raw font file of a face, either from the font face asset or loaded from disk
+	static bool LoadFontBytes(FFontData const& FontData, TArray<uint8>& OutBytes);
+
+	// drops all cached bitmaps, e.g. after font assets were reimported
+	static void ClearCache();
+
+private:
+	struct FFaceEntry
+	{
+		TSharedRef<TBitArray<> const> Coverage;
+		uint64 ContentHash = 0;
+		bool bComplete = true;
+	};
+
+	static FFaceEntry FindOrAddFace(FFontData const& FontData);
+
+	static FCriticalSection CacheLock;
+	static TMap<FFontData, FFaceEntry> FaceCache;
+};
@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserFontDataSubsystem.h"
+
+#include "Editor.h"
+
+#include "Async/Async.h"
+
+#include "Engine/Font.h"
+#include "Engine/FontFace.h"
+
+#include "Fonts/CompositeFont.h"
+#include "Fonts/SlateFontInfo.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointTable.h"
+#include "UnicodeBrowser/UnicodeBrowserFontCoverage.h"
+#include "UnicodeBrowser/UnicodeBrowserOptions.h"
+#include "UnicodeBrowser/UnicodeBrowserStatic.h"
+
+#include "UObject/StrongObjectPtr.h"
+
+namespace UnicodeBrowser::FontData
+{
+	// the font face assets of all typefaces, the background task reads their data
+	void GetFontFaces(FCompositeFont const& CompositeFont, TArray<TStrongObjectPtr<UObject>>& OutFaces)
+	{
+		auto AddTypeface = [&OutFaces](FTypeface const& Typeface)
+		{
+			for (FTypefaceEntry const& Entry : Typeface.Fonts)
+			{
+				if (UObject const* FontFace = Entry.Font.GetFontFaceAsset())
+				{
+					OutFaces.Emplace(const_cast<UObject*>(FontFace));
+				}
+			}
+		};
+
+		AddTypeface(CompositeFont.DefaultTypeface);
+		AddTypeface(CompositeFont.FallbackTypeface.Typeface);
+		for (FCompositeSubFont const& SubFont : CompositeFont.SubTypefaces)
+		{
+			AddTypeface(SubFont.Typeface);
+		}
+	}
+}
+
+UUnicodeBrowserFontDataSubsystem::FFontKey::FFontKey(FSlateFontInfo const& FontInfo)
+	: FontObject(FontInfo.FontObject)
+	, CompositeFont(FontInfo.FontObject ? nullptr : FontInfo.GetCompositeFont())
+	, TypefaceFontName(FontInfo.TypefaceFontName)
+{
+}
+
+UUnicodeBrowserFontDataSubsystem* UUnicodeBrowserFontDataSubsystem::Get()
+{
+	return GEditor ? GEditor->GetEditorSubsystem<UUnicodeBrowserFontDataSubsystem>() : nullptr;
+}
+
+void UUnicodeBrowserFontDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UUnicodeBrowserFontDataSubsystem::OnObjectPropertyChanged);
+}
+
+void UUnicodeBrowserFontDataSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TrimTickerHandle);
+
+	for (auto const& [Key, Entry] : Tables)
+	{
+		Entry.Table->SaveCachedMetrics();
+	}
+
+	Tables.Reset();
+	for (auto const& [Key, Run] : PendingRequests)
+	{
+		*Run.bCanceled = true;
+	}
+
+	PendingRequests.Reset();
+
+	Super::Deinitialize();
+}
+
+TSharedPtr<FUnicodeBrowserCodepointTable> UUnicodeBrowserFontDataSubsystem::FindTable(FSlateFontInfo const& FontInfo)
+{
+	if (FEntry* Entry = Tables.Find(FFontKey(FontInfo)))
+	{
+		Entry->LastUsedTime = FPlatformTime::Seconds();
+		return Entry->Table;
+	}
+
+	return nullptr;
+}
+
+void UUnicodeBrowserFontDataSubsystem::RequestTable(FSlateFontInfo const& FontInfo, FOnTableReady OnReady)
+{
+	if (TSharedPtr<FUnicodeBrowserCodepointTable> const Table = FindTable(FontInfo))
+	{
+		OnReady.ExecuteIfBound(Table.ToSharedRef());
+		return;
+	}
+
+	FFontKey const Key(FontInfo);
+	if (FPendingRun* Pending = PendingRequests.Find(Key))
+	{
+		// a run for this font is already in flight
+		Pending->Requests.Add(MoveTemp(OnReady));
+		return;
+	}
+
+	FPendingRun& Run = PendingRequests.Add(Key);
+	Run.Requests.Add(MoveTemp(OnReady));
+	TSharedRef<FThreadSafeBool> const bCanceled = Run.bCanceled;
+
+	// the background task works on a copy of the composite font, the UFont may change while the task is running
+	// the font faces are kept alive until the task is done, the references are released on the game thread again
+	FCompositeFont const* CompositeFont = FontInfo.GetCompositeFont();
+	TSharedPtr<FCompositeFont const> CompositeFontCopy = CompositeFont ? MakeShared<FCompositeFont>(*CompositeFont) : nullptr;
+	TArray<TStrongObjectPtr<UObject>> FontFaces;
+	if (CompositeFont)
+	{
+		UnicodeBrowser::FontData::GetFontFaces(*CompositeFont, FontFaces);
+	}
+
+	Async(
+		EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakObjectPtr<UUnicodeBrowserFontDataSubsystem>(this), Key, BuildGeneration = Generation, FontInfo, CompositeFontCopy, FontFaces = MoveTemp(FontFaces), bCanceled]() mutable
+		{
+			// every step checks whether all requests went away in the meantime
+			TSharedPtr<FUnicodeBrowserCodepointTable> Table;
+			bool bComplete = true;
+			if (!*bCanceled)
+			{
+				// reading the cmap tables is the expensive part, it only needs the font files
+				uint64 FontKey = 0;
+				TSharedRef<TBitArray<> const> Coverage = CompositeFontCopy.IsValid()
+					? FUnicodeBrowserFontCoverage::GetFontCoverage(*CompositeFontCopy, FontInfo.TypefaceFontName, &FontKey, &bComplete)
+					: TSharedRef<TBitArray<> const>(MakeShared<TBitArray<>>(false, FUnicodeBrowserFontCoverage::NumCodepoints));
+
+				// faces without a readable cmap are probed through the font cache on the game thread, so the table is created there
+				// also picks up the glyph metrics of a previous session from the on-disk cache
+				if (bComplete && !*bCanceled)
+				{
+					Table = FUnicodeBrowserCodepointTable::Create(FontInfo, UnicodeBrowser::GetUnicodeBlockRanges(), Coverage, FontKey, &bCanceled.Get());
+				}
+			}
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[WeakThis, Key, BuildGeneration, FontInfo, CompositeFontCopy, FontFaces = MoveTemp(FontFaces), bCanceled, Table]()
+				{
+					// a canceled run only releases the font faces
+					UUnicodeBrowserFontDataSubsystem* Subsystem = WeakThis.Get();
+					if (!Subsystem || *bCanceled)
+						return;
+
+					TSharedPtr<FUnicodeBrowserCodepointTable> Result = Table;
+					if (!Result.IsValid())
+					{
+						uint64 FontKey = 0;
+						TSharedRef<TBitArray<> const> const Coverage = FUnicodeBrowserFontCoverage::GetFontCoverage(*CompositeFontCopy, FontInfo.TypefaceFontName, &FontKey);
+						Result = FUnicodeBrowserCodepointTable::Create(FontInfo, UnicodeBrowser::GetUnicodeBlockRanges(), Coverage, FontKey);
+					}
+
+					Subsystem->OnTableBuilt(Key, BuildGeneration, Result.ToSharedRef());
+				}
+			);
+		}
+	);
+}
+
+void UUnicodeBrowserFontDataSubsystem::OnTableBuilt(FFontKey const& Key, int32 const BuildGeneration, TSharedRef<FUnicodeBrowserCodepointTable> const& Table)
+{
+	FPendingRun Run;
+	PendingRequests.RemoveAndCopyValue(Key, Run);
+
+	// tables of fonts which changed while the task was running are only handed out once
+	if (BuildGeneration == Generation)
+	{
+		Tables.Add(Key, FEntry{Table, FPlatformTime::Seconds()});
+	}
+
+	for (FOnTableReady const& Request : Run.Requests)
+	{
+		Request.ExecuteIfBound(Table);
+	}
+
+	RequestTrim();
+}
+
+void UUnicodeBrowserFontDataSubsystem::CancelRequests(void const* const Requester)
+{
+	for (auto It = PendingRequests.CreateIterator(); It; ++It)
+	{
+		FPendingRun& Run = It.Value();
+		Run.Requests.RemoveAll([Requester](FOnTableReady const& Request) { return !Request.IsBound() || Request.IsBoundToObject(Requester); });
+		if (Run.Requests.IsEmpty())
+		{
+			*Run.bCanceled = true;
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UUnicodeBrowserFontDataSubsystem::RequestTrim()
+{
+	if (TrimTickerHandle.IsValid())
+		return;
+
+	// deferred, the browser which released a table may still hold rows of it while it's destructed
+	TrimTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateWeakLambda(
+			this,
+			[this](float)
+			{
+				TrimTickerHandle.Reset();
+				Trim();
+				return false;
+			}
+		)
+	);
+}
+
+void UUnicodeBrowserFontDataSubsystem::Trim()
+{
+	SIZE_T const Budget = static_cast<SIZE_T>(FMath::Max(UUnicodeBrowserOptions::Get()->FontDataMemoryBudgetMB, 0)) * 1024 * 1024;
+	SIZE_T RetainedMemory = GetRetainedMemory();
+	if (RetainedMemory <= Budget)
+		return;
+
+	// tables which are in use by a browser are never released
+	TArray<FFontKey> Unreferenced;
+	for (auto const& [Key, Entry] : Tables)
+	{
+		if (Entry.Table.IsUnique())
+		{
+			Unreferenced.Add(Key);
+		}
+	}
+
+	Unreferenced.Sort([this](FFontKey const& A, FFontKey const& B) { return Tables[A].LastUsedTime < Tables[B].LastUsedTime; });
+
+	for (FFontKey const& Key : Unreferenced)
+	{
+		if (RetainedMemory <= Budget)
+			break;
+
+		FEntry const Entry = Tables.FindAndRemoveChecked(Key);
+		RetainedMemory -= Entry.Table->GetAllocatedSize();
+		Entry.Table->SaveCachedMetrics();
+	}
+}
+
+void UUnicodeBrowserFontDataSubsystem::Invalidate()
+{
+	for (auto const& [Key, Entry] : Tables)
+	{
+		Entry.Table->SaveCachedMetrics();
+	}
+
+	Tables.Reset();
+	++Generation;
+
+	// the face coverage is cached per font data, the files on disk are keyed by content and stay valid
+	FUnicodeBrowserFontCoverage::ClearCache();
+
+	OnFontDataInvalidated.Broadcast();
+}
+
+SIZE_T UUnicodeBrowserFontDataSubsystem::GetRetainedMemory() const
+{
+	SIZE_T Size = 0;
+	for (auto const& [Key, Entry] : Tables)
+	{
+		Size += Entry.Table->GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+void UUnicodeBrowserFontDataSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// editing a font or a font face may change the glyphs of any retained table
+	if (Object && (Object->IsA<UFont>() || Object->IsA<UFontFace>()))
+	{
+		Invalidate();
+	}
+}
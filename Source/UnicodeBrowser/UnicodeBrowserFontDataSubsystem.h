@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+
+#include "EditorSubsystem.h"
+
+#include "HAL/ThreadSafeBool.h"
+
+#include "UObject/ObjectKey.h"
+
+#include "UnicodeBrowserFontDataSubsystem.generated.h"
+
+class FUnicodeBrowserCodepointTable;
+struct FSlateFontInfo;
+
+/**
+ * owns the codepoint tables of all fonts which are shown by any Unicode Browser
+ * tables are shared between all browser instances and are retained after the last browser closed,
+ * unreferenced tables are released (least recently used first) once the memory budget from the options is exceeded
+ */
+UCLASS()
+class UNICODEBROWSER_API UUnicodeBrowserFontDataSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	DECLARE_DELEGATE_OneParam(FOnTableReady, TSharedRef<FUnicodeBrowserCodepointTable> const&);
+
+	DECLARE_MULTICAST_DELEGATE(FOnFontDataInvalidated);
+	FOnFontDataInvalidated OnFontDataInvalidated;
+
+	static UUnicodeBrowserFontDataSubsystem* Get();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// returns the table of the font if it's already available
+	// the table is shared, its font info is the one of the first request, browsers apply their own style
+	TSharedPtr<FUnicodeBrowserCodepointTable> FindTable(FSlateFontInfo const& FontInfo);
+
+	// builds the table of the font on a worker thread, OnReady is called on the game thread
+	// concurrent requests for the same font share a single run
+	void RequestTable(FSlateFontInfo const& FontInfo, FOnTableReady OnReady);
+
+	// drops the pending requests whose delegates are bound to the requester,
+	// a run without any requests left is canceled and its worker stops at the next check
+	void CancelRequests(void const* Requester);
+
+	// releases unreferenced tables on the next tick if the retained tables exceed the memory budget
+	void RequestTrim();
+
+	// releases all tables (e.g. after fonts were changed), browsers need to request their tables again
+	void Invalidate();
+
+	SIZE_T GetRetainedMemory() const;
+
+protected:
+	struct FFontKey
+	{
+		FObjectKey FontObject;
+		void const* CompositeFont = nullptr; // fonts without an asset (e.g. the default Slate font) are identified by their composite font
+		FName TypefaceFontName;
+
+		explicit FFontKey(FSlateFontInfo const& FontInfo);
+
+		bool operator==(FFontKey const& Other) const
+		{
+			return FontObject == Other.FontObject && CompositeFont == Other.CompositeFont && TypefaceFontName == Other.TypefaceFontName;
+		}
+
+		friend uint32 GetTypeHash(FFontKey const& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.FontObject), GetTypeHash(Key.CompositeFont)), GetTypeHash(Key.TypefaceFontName));
+		}
+	};
+
+	struct FEntry
+	{
+		TSharedPtr<FUnicodeBrowserCodepointTable> Table;
+		double LastUsedTime = 0.0;
+	};
+
+	struct FPendingRun
+	{
+		TArray<FOnTableReady> Requests;
+		TSharedRef<FThreadSafeBool> bCanceled = MakeShared<FThreadSafeBool>(false);
+	};
+
+	void OnTableBuilt(FFontKey const& Key, int32 BuildGeneration, TSharedRef<FUnicodeBrowserCodepointTable> const& Table);
+	void Trim();
+	void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+
+	TMap<FFontKey, FEntry> Tables;
+	TMap<FFontKey, FPendingRun> PendingRequests;
+
+	// incremented by Invalidate, results of older runs are handed to the requests but not retained
+	int32 Generation = 0;
+
+	FTSTicker::FDelegateHandle TrimTickerHandle;
+	FDelegateHandle OnObjectPropertyChangedHandle;
+};
@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserGlyphCache.h"
+
+#include "Async/MappedFileHandle.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+#include "Hash/CityHash.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace UnicodeBrowser::GlyphCache
+{
+	uint32 constexpr CoverageMagic = 0x55424356; // UBCV
+	uint32 constexpr MetricsMagic = 0x55424D54; // UBMT
+
+	struct FCoverageHeader
+	{
+		uint32 Magic = CoverageMagic;
+		uint32 Version = FUnicodeBrowserGlyphCache::Version;
+		uint64 FaceHash = 0;
+		int32 SubFaceIndex = 0;
+		int32 NumBits = 0;
+	};
+
+	struct FMetricsHeader
+	{
+		uint32 Magic = MetricsMagic;
+		uint32 Version = FUnicodeBrowserGlyphCache::Version;
+		uint64 FontKey = 0;
+		int32 NumEntries = 0;
+		int32 Padding = 0;
+	};
+
+	template <typename T>
+	void AppendRaw(TArray<uint8>& Data, T const* Values, int32 const Num)
+	{
+		Data.Append(reinterpret_cast<uint8 const*>(Values), Num * sizeof(T));
+	}
+}
+
+using namespace UnicodeBrowser::GlyphCache;
+
+FString FUnicodeBrowserGlyphCache::GetCacheDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("UnicodeBrowser") / TEXT("GlyphCache");
+}
+
+uint64 FUnicodeBrowserGlyphCache::HashFontBytes(TConstArrayView<uint8> const FontBytes)
+{
+	return CityHash64(reinterpret_cast<char const*>(FontBytes.GetData()), FontBytes.Num());
+}
+
+uint64 FUnicodeBrowserGlyphCache::CombineKey(uint64 const Key, uint64 const Value)
+{
+	return CityHash64WithSeed(reinterpret_cast<char const*>(&Value), sizeof(Value), Key);
+}
+
+uint64 FUnicodeBrowserGlyphCache::CombineKey(uint64 const Key, FName const Value)
+{
+	FString const Name = Value.ToString();
+	return CityHash64WithSeed(reinterpret_cast<char const*>(*Name), Name.Len() * sizeof(TCHAR), Key);
+}
+
+bool FUnicodeBrowserGlyphCache::LoadCoverage(uint64 const FaceHash, int32 const SubFaceIndex, TBitArray<>& OutCoverage)
+{
+	return ReadMapped(
+		GetCoverageFilename(FaceHash, SubFaceIndex),
+		[FaceHash, SubFaceIndex, &OutCoverage](TConstArrayView<uint8> const Data)
+		{
+			if (Data.Num() < static_cast<int32>(sizeof(FCoverageHeader)))
+				return false;
+
+			FCoverageHeader Header;
+			FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+
+			int32 const NumWords = FMath::DivideAndRoundUp(Header.NumBits, static_cast<int32>(NumBitsPerDWORD));
+			if (Header.Magic != CoverageMagic || Header.Version != Version || Header.FaceHash != FaceHash || Header.SubFaceIndex != SubFaceIndex
+				|| Header.NumBits <= 0 || Data.Num() != static_cast<int32>(sizeof(Header)) + NumWords * static_cast<int32>(sizeof(uint32)))
+				return false;
+
+			OutCoverage.Init(false, Header.NumBits);
+			FMemory::Memcpy(OutCoverage.GetData(), Data.GetData() + sizeof(Header), NumWords * sizeof(uint32));
+			return true;
+		}
+	);
+}
+
+void FUnicodeBrowserGlyphCache::SaveCoverage(uint64 const FaceHash, int32 const SubFaceIndex, TBitArray<> const& Coverage)
+{
+	FCoverageHeader Header;
+	Header.FaceHash = FaceHash;
+	Header.SubFaceIndex = SubFaceIndex;
+	Header.NumBits = Coverage.Num();
+
+	int32 const NumWords = FMath::DivideAndRoundUp(Header.NumBits, static_cast<int32>(NumBitsPerDWORD));
+
+	TArray<uint8> Data;
+	Data.Reserve(sizeof(Header) + NumWords * sizeof(uint32));
+	AppendRaw(Data, &Header, 1);
+	AppendRaw(Data, Coverage.GetData(), NumWords);
+
+	WriteAtomic(GetCoverageFilename(FaceHash, SubFaceIndex), Data);
+}
+
+int32 FUnicodeBrowserGlyphCache::LoadMetrics(uint64 const FontKey, TFunctionRef<void(int32 Codepoint, FVector2f NormalizedMeasurement)> ApplyMeasurement)
+{
+	int32 NumApplied = 0;
+	ReadMapped(
+		GetMetricsFilename(FontKey),
+		[FontKey, &ApplyMeasurement, &NumApplied](TConstArrayView<uint8> const Data)
+		{
+			if (Data.Num() < static_cast<int32>(sizeof(FMetricsHeader)))
+				return false;
+
+			FMetricsHeader Header;
+			FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+
+			int64 const ExpectedSize = sizeof(Header) + static_cast<int64>(Header.NumEntries) * (sizeof(int32) + sizeof(FVector2f));
+			if (Header.Magic != MetricsMagic || Header.Version != Version || Header.FontKey != FontKey || Header.NumEntries < 0 || Data.Num() != ExpectedSize)
+				return false;
+
+			// the sections are 4 byte aligned, so they can be read straight from the mapped memory
+			int32 const* Codepoints = reinterpret_cast<int32 const*>(Data.GetData() + sizeof(Header));
+			FVector2f const* Measurements = reinterpret_cast<FVector2f const*>(Codepoints + Header.NumEntries);
+			for (int32 Entry = 0; Entry < Header.NumEntries; ++Entry)
+			{
+				ApplyMeasurement(Codepoints[Entry], Measurements[Entry]);
+			}
+
+			NumApplied = Header.NumEntries;
+			return true;
+		}
+	);
+
+	return NumApplied;
+}
+
+void FUnicodeBrowserGlyphCache::SaveMetrics(uint64 const FontKey, TConstArrayView<int32> const Codepoints, TConstArrayView<FVector2f> const NormalizedMeasurements)
+{
+	if (!ensure(Codepoints.Num() == NormalizedMeasurements.Num()))
+		return;
+
+	FMetricsHeader Header;
+	Header.FontKey = FontKey;
+	Header.NumEntries = Codepoints.Num();
+
+	TArray<uint8> Data;
+	Data.Reserve(sizeof(Header) + Codepoints.Num() * (sizeof(int32) + sizeof(FVector2f)));
+	AppendRaw(Data, &Header, 1);
+	AppendRaw(Data, Codepoints.GetData(), Codepoints.Num());
+	AppendRaw(Data, NormalizedMeasurements.GetData(), NormalizedMeasurements.Num());
+
+	WriteAtomic(GetMetricsFilename(FontKey), Data);
+}
+
+void FUnicodeBrowserGlyphCache::ClearCache()
+{
+	IFileManager::Get().DeleteDirectory(*GetCacheDir(), false, true);
+}
+
+FString FUnicodeBrowserGlyphCache::GetCoverageFilename(uint64 const FaceHash, int32 const SubFaceIndex)
+{
+	return GetCacheDir() / FString::Printf(TEXT("%016llx_%d.ubcov"), FaceHash, SubFaceIndex);
+}
+
+FString FUnicodeBrowserGlyphCache::GetMetricsFilename(uint64 const FontKey)
+{
+	return GetCacheDir() / FString::Printf(TEXT("%016llx.ubmet"), FontKey);
+}
+
+bool FUnicodeBrowserGlyphCache::ReadMapped(FString const& Filename, TFunctionRef<bool(TConstArrayView<uint8> Data)> Reader)
+{
+	TUniquePtr<IMappedFileHandle> const MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!MappedFile.IsValid() || MappedFile->GetFileSize() <= 0 || MappedFile->GetFileSize() > MAX_int32)
+		return false;
+
+	TUniquePtr<IMappedFileRegion> const MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	if (!MappedRegion.IsValid())
+		return false;
+
+	bool const bResult = Reader(TConstArrayView<uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize())));
+	if (!bResult)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[FUnicodeBrowserGlyphCache] Ignoring outdated cache file %s"), *Filename);
+	}
+
+	return bResult;
+}
+
+void FUnicodeBrowserGlyphCache::WriteAtomic(FString const& Filename, TArray<uint8> const& Data)
+{
+	// write to a temporary file first, so a concurrent reader never sees a partially written file
+	FString const TempFilename = FString::Printf(TEXT("%s.%s.tmp"), *Filename, *FGuid::NewGuid().ToString());
+	if (FFileHelper::SaveArrayToFile(Data, *TempFilename))
+	{
+		if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+		{
+			IFileManager::Get().Delete(*TempFilename, false, true, true);
+		}
+	}
+}
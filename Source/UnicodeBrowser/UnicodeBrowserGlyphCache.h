@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * versioned on-disk cache for data which is expensive to compute per font
+ * face coverage is keyed by the content hash of the font file and the subface index,
+ * glyph metrics are keyed by the combined hashes of all faces of a composite font and the typeface
+ * metrics are stored normalized to the font size, so they are valid for every size of the font
+ * files are located in Saved/UnicodeBrowser/GlyphCache and are memory mapped for reading
+ */
+class UNICODEBROWSER_API FUnicodeBrowserGlyphCache
+{
+public:
+	// bump this whenever the layout of the files or the way the data is computed changes
+	static constexpr uint32 Version = 1;
+
+	static FString GetCacheDir();
+
+	static uint64 HashFontBytes(TConstArrayView<uint8> FontBytes);
+	static uint64 CombineKey(uint64 Key, uint64 Value);
+	static uint64 CombineKey(uint64 Key, FName Value);
+
+	static bool LoadCoverage(uint64 FaceHash, int32 SubFaceIndex, TBitArray<>& OutCoverage);
+	static void SaveCoverage(uint64 FaceHash, int32 SubFaceIndex, TBitArray<> const& Coverage);
+
+	// hands the normalized measurements of all cached codepoints to ApplyMeasurement
+	// @return the amount of cached measurements
+	static int32 LoadMetrics(uint64 FontKey, TFunctionRef<void(int32 Codepoint, FVector2f NormalizedMeasurement)> ApplyMeasurement);
+	static void SaveMetrics(uint64 FontKey, TConstArrayView<int32> Codepoints, TConstArrayView<FVector2f> NormalizedMeasurements);
+
+	// removes all cache files, e.g. if the cache got corrupted
+	static void ClearCache();
+
+private:
+	static FString GetCoverageFilename(uint64 FaceHash, int32 SubFaceIndex);
+	static FString GetMetricsFilename(uint64 FontKey);
+
+	// maps the file and hands the mapped memory to the reader, returns false if the file doesn't exist
+	static bool ReadMapped(FString const& Filename, TFunctionRef<bool(TConstArrayView<uint8> Data)> Reader);
+	static void WriteAtomic(FString const& Filename, TArray<uint8> const& Data);
+};
@@ -0,0 +1,303 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserNameIndex.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+
+THIRD_PARTY_INCLUDES_START
+#include <unicode/uchar.h>
+THIRD_PARTY_INCLUDES_END
+
+namespace UnicodeBrowser::NameIndex
+{
+	using FOnName = TFunctionRef<void(int32 Codepoint, FAnsiStringView Name)>;
+
+	UBool U_CALLCONV OnEnumName(void* const Context, UChar32 const Codepoint, UCharNameChoice, char const* const Name, int32_t const Length)
+	{
+		(*static_cast<FOnName*>(Context))(Codepoint, FAnsiStringView(Name, Length));
+		return true;
+	}
+}
+
+FUnicodeBrowserNameIndex const& FUnicodeBrowserNameIndex::Get()
+{
+	// function local statics are initialized exactly once, concurrent callers wait for the first one
+	static FUnicodeBrowserNameIndex const Index;
+	return Index;
+}
+
+FUnicodeBrowserNameIndex::FUnicodeBrowserNameIndex()
+{
+	double const StartTime = FPlatformTime::Seconds();
+
+	TMap<FString, TArray<int32>> WordCodepoints;
+
+	auto Enumerate = [&WordCodepoints](FNamePool& Pool, UCharNameChoice const NameChoice)
+	{
+		auto AddName = [&WordCodepoints, &Pool](int32 const Codepoint, FAnsiStringView const Name)
+		{
+			Pool.Add(Codepoint, Name);
+
+			int32 WordStart = 0;
+			for (int32 Position = 0; Position <= Name.Len(); ++Position)
+			{
+				if (Position < Name.Len() && !IsWordDelimiter(Name[Position]))
+					continue;
+
+				if (Position > WordStart)
+				{
+					TArray<int32>& Codepoints = WordCodepoints.FindOrAdd(FString(Position - WordStart, Name.GetData() + WordStart));
+					if (Codepoints.IsEmpty() || Codepoints.Last() != Codepoint)
+					{
+						Codepoints.Add(Codepoint);
+					}
+				}
+
+				WordStart = Position + 1;
+			}
+		};
+
+		UnicodeBrowser::NameIndex::FOnName OnName = AddName;
+		UErrorCode ErrorCode = U_ZERO_ERROR;
+		u_enumCharNames(0, UCHAR_MAX_VALUE + 1, &UnicodeBrowser::NameIndex::OnEnumName, &OnName, NameChoice, &ErrorCode);
+
+		if (U_FAILURE(ErrorCode))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[FUnicodeBrowserNameIndex::FUnicodeBrowserNameIndex] Failed to enumerate the Unicode character names: %hs"), u_errorName(ErrorCode));
+		}
+
+		Pool.LastName.Empty();
+	};
+
+	Enumerate(Names, U_UNICODE_CHAR_NAME);
+	Enumerate(Aliases, U_CHAR_NAME_ALIAS);
+
+	TArray<FString> Words;
+	WordCodepoints.GenerateKeyArray(Words);
+	Algo::Sort(Words, [](FString const& A, FString const& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+	WordOffsets.Reserve(Words.Num() + 1);
+	PostingOffsets.Reserve(Words.Num() + 1);
+
+	for (FString const& Word : Words)
+	{
+		WordOffsets.Add(WordBytes.Num());
+		for (TCHAR const Char : Word)
+		{
+			WordBytes.Add(static_cast<ANSICHAR>(Char));
+		}
+		WordBytes.Add('\0');
+
+		// aliases are enumerated after the names, so their codepoints may be out of order
+		TArray<int32>& Codepoints = WordCodepoints[Word];
+		Algo::Sort(Codepoints);
+		Codepoints.SetNum(Algo::Unique(Codepoints));
+
+		PostingOffsets.Add(Postings.Num());
+		Postings.Append(Codepoints);
+	}
+
+	WordOffsets.Add(WordBytes.Num());
+	PostingOffsets.Add(Postings.Num());
+
+	UE_LOG(
+		LogTemp,
+		Log,
+		TEXT("[FUnicodeBrowserNameIndex::FUnicodeBrowserNameIndex] Indexed %d character names and %d aliases (%d words, %llu KiB) in %.1f ms"),
+		Names.Codepoints.Num(),
+		Aliases.Codepoints.Num(),
+		Words.Num(),
+		static_cast<uint64>(GetAllocatedSize() / 1024),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0
+	);
+}
+
+FString FUnicodeBrowserNameIndex::GetName(int32 const Codepoint) const
+{
+	FString Name;
+	Names.Find(Codepoint, Name);
+	return Name;
+}
+
+FString FUnicodeBrowserNameIndex::GetAlias(int32 const Codepoint) const
+{
+	FString Alias;
+	Aliases.Find(Codepoint, Alias);
+	return Alias;
+}
+
+void FUnicodeBrowserNameIndex::FindCodepoints(FStringView const Query, FUnicodeBrowserCodepointSet& OutCodepoints) const
+{
+	// names are plain ASCII, so a query with any other character can't match
+	TArray<ANSICHAR, TInlineAllocator<128>> Folded;
+	for (TCHAR const Char : Query)
+	{
+		if (static_cast<uint32>(Char) > 127)
+			return;
+
+		ANSICHAR const AnsiChar = static_cast<ANSICHAR>(Char);
+		Folded.Add(FCharAnsi::IsWhitespace(AnsiChar) ? ' ' : FCharAnsi::ToUpper(AnsiChar));
+	}
+
+	TArray<FAnsiStringView, TInlineAllocator<8>> QueryWords;
+	int32 WordStart = 0;
+	for (int32 Position = 0; Position <= Folded.Num(); ++Position)
+	{
+		if (Position < Folded.Num() && !IsWordDelimiter(Folded[Position]))
+			continue;
+
+		if (Position > WordStart)
+		{
+			QueryWords.Emplace(Folded.GetData() + WordStart, Position - WordStart);
+		}
+
+		WordStart = Position + 1;
+	}
+
+	if (QueryWords.IsEmpty())
+		return;
+
+	// the last word is still being typed unless it's followed by a delimiter
+	bool const bLastWordIncomplete = !IsWordDelimiter(Folded.Last());
+	int32 const NumWords = WordOffsets.Num() - 1;
+
+	// codepoints per query word, a prefix may match several words of the index
+	TArray<TArray<int32>, TInlineAllocator<8>> Lists;
+	for (int32 QueryWordIndex = 0; QueryWordIndex < QueryWords.Num(); ++QueryWordIndex)
+	{
+		FAnsiStringView const QueryWord = QueryWords[QueryWordIndex];
+		bool const bPrefix = bLastWordIncomplete && QueryWordIndex == QueryWords.Num() - 1 && QueryWord.Len() >= MinPrefixLength;
+
+		int32 const First = LowerBoundWord(QueryWord);
+		int32 Last = First;
+		while (Last < NumWords && (bPrefix ? GetWord(Last).StartsWith(QueryWord, ESearchCase::CaseSensitive) : GetWord(Last).Equals(QueryWord, ESearchCase::CaseSensitive)))
+		{
+			++Last;
+		}
+
+		if (First == Last)
+			return;
+
+		TArray<int32>& List = Lists.AddDefaulted_GetRef();
+		for (int32 Word = First; Word < Last; ++Word)
+		{
+			List.Append(Postings.GetData() + PostingOffsets[Word], PostingOffsets[Word + 1] - PostingOffsets[Word]);
+		}
+
+		if (Last - First > 1)
+		{
+			Algo::Sort(List);
+			List.SetNum(Algo::Unique(List));
+		}
+	}
+
+	// walk the shortest list, the others are only probed
+	Lists.Sort([](TArray<int32> const& A, TArray<int32> const& B) { return A.Num() < B.Num(); });
+
+	for (int32 const Codepoint : Lists[0])
+	{
+		bool bInAll = true;
+		for (int32 ListIndex = 1; ListIndex < Lists.Num() && bInAll; ++ListIndex)
+		{
+			bInAll = Algo::BinarySearch(Lists[ListIndex], Codepoint) != INDEX_NONE;
+		}
+
+		if (bInAll)
+		{
+			OutCodepoints.Add(Codepoint);
+		}
+	}
+}
+
+SIZE_T FUnicodeBrowserNameIndex::GetAllocatedSize() const
+{
+	return Names.GetAllocatedSize() + Aliases.GetAllocatedSize()
+		+ WordBytes.GetAllocatedSize() + WordOffsets.GetAllocatedSize() + PostingOffsets.GetAllocatedSize() + Postings.GetAllocatedSize();
+}
+
+FAnsiStringView FUnicodeBrowserNameIndex::GetWord(int32 const WordIndex) const
+{
+	// excludes the zero terminator
+	return FAnsiStringView(WordBytes.GetData() + WordOffsets[WordIndex], WordOffsets[WordIndex + 1] - WordOffsets[WordIndex] - 1);
+}
+
+int32 FUnicodeBrowserNameIndex::LowerBoundWord(FAnsiStringView const Word) const
+{
+	int32 First = 0;
+	int32 Count = WordOffsets.Num() - 1;
+	while (Count > 0)
+	{
+		int32 const Step = Count / 2;
+		if (GetWord(First + Step).Compare(Word, ESearchCase::CaseSensitive) < 0)
+		{
+			First += Step + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+
+	return First;
+}
+
+void FUnicodeBrowserNameIndex::FNamePool::Add(int32 const Codepoint, FAnsiStringView const Name)
+{
+	int32 const Length = FMath::Min(Name.Len(), 255);
+
+	// the first name of a bucket is stored in full, so any name can be decoded from the start of its bucket
+	int32 Shared = 0;
+	if (Codepoints.Num() % BucketSize == 0)
+	{
+		BucketOffsets.Add(Bytes.Num());
+	}
+	else
+	{
+		int32 const MaxShared = FMath::Min(Length, LastName.Num());
+		while (Shared < MaxShared && LastName[Shared] == Name[Shared])
+		{
+			++Shared;
+		}
+	}
+
+	Codepoints.Add(Codepoint);
+	Bytes.Add(static_cast<uint8>(Shared));
+	Bytes.Add(static_cast<uint8>(Length - Shared));
+	Bytes.Append(reinterpret_cast<uint8 const*>(Name.GetData()) + Shared, Length - Shared);
+
+	LastName.Reset();
+	LastName.Append(Name.GetData(), Length);
+}
+
+bool FUnicodeBrowserNameIndex::FNamePool::Find(int32 const Codepoint, FString& OutName) const
+{
+	int32 const Index = Algo::BinarySearch(Codepoints, Codepoint);
+	if (Index == INDEX_NONE)
+		return false;
+
+	TArray<ANSICHAR, TInlineAllocator<256>> Name;
+	int32 Offset = BucketOffsets[Index / BucketSize];
+
+	for (int32 Entry = Index - Index % BucketSize; Entry <= Index; ++Entry)
+	{
+		int32 const Shared = Bytes[Offset];
+		int32 const SuffixLength = Bytes[Offset + 1];
+
+		Name.SetNum(Shared);
+		Name.Append(reinterpret_cast<ANSICHAR const*>(Bytes.GetData() + Offset + 2), SuffixLength);
+		Offset += 2 + SuffixLength;
+	}
+
+	OutName = FString(Name.Num(), Name.GetData());
+	return true;
+}
+
+SIZE_T FUnicodeBrowserNameIndex::FNamePool::GetAllocatedSize() const
+{
+	return Codepoints.GetAllocatedSize() + BucketOffsets.GetAllocatedSize() + Bytes.GetAllocatedSize();
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FUnicodeBrowserCodepointSet;
+
+/**
+ * the official Unicode names and name aliases of all codepoints, enumerated once from ICU
+ * names are stored front coded in buckets of consecutive codepoints, neighbouring names share most of their bytes
+ * every word of a name or alias maps to the sorted codepoints which use it, a query intersects these lists word by word
+ */
+class UNICODEBROWSER_API FUnicodeBrowserNameIndex
+{
+public:
+	// built on the first call, safe to call from any thread
+	static FUnicodeBrowserNameIndex const& Get();
+
+	// empty if the codepoint has no name
+	FString GetName(int32 Codepoint) const;
+	FString GetAlias(int32 Codepoint) const;
+
+	// adds all codepoints whose name or alias contains every word of the query (case-insensitive), the last word may be incomplete
+	void FindCodepoints(FStringView Query, FUnicodeBrowserCodepointSet& OutCodepoints) const;
+
+	int32 NumNames() const { return Names.Codepoints.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	FUnicodeBrowserNameIndex();
+
+	static constexpr int32 MinPrefixLength = 3; // shorter words are only matched as a whole
+
+	struct FNamePool
+	{
+		static constexpr int32 BucketSize = 16;
+
+		TArray<int32> Codepoints; // ascending
+		TArray<int32> BucketOffsets; // the first byte of every bucket within Bytes
+		TArray<uint8> Bytes; // per name: the length of the prefix shared with the previous name, the length of the suffix, the suffix
+		TArray<ANSICHAR> LastName; // only used while adding
+
+		void Add(int32 Codepoint, FAnsiStringView Name);
+		bool Find(int32 Codepoint, FString& OutName) const;
+		SIZE_T GetAllocatedSize() const;
+	};
+
+	static bool IsWordDelimiter(ANSICHAR Char) { return Char == ' ' || Char == '-'; }
+
+	FAnsiStringView GetWord(int32 WordIndex) const;
+	int32 LowerBoundWord(FAnsiStringView Word) const;
+
+	FNamePool Names;
+	FNamePool Aliases;
+
+	TArray<ANSICHAR> WordBytes; // all distinct words in ascending order, zero terminated
+	TArray<int32> WordOffsets; // the first char of every word within WordBytes, plus the total
+	TArray<int32> PostingOffsets; // the first codepoint of every word within Postings, plus the total
+	TArray<int32> Postings;
+};
@@ -45,12 +45,31 @@ public:
 	UPROPERTY(Config, EditAnywhere)
 	bool bAutoSetRangeOnFontChange = false;
 
+	// memory which may be used by the character data of fonts which are not shown by any browser, this keeps reopening the browser fast
+	UPROPERTY(Config, EditAnywhere, meta=(UIMin=0, Units="Megabytes"))
+	int32 FontDataMemoryBudgetMB = 64;
+
 	UPROPERTY(Config, EditAnywhere)
 	bool bSearch_AutoSetRange = true;
 
 	UPROPERTY(Config, EditAnywhere)
 	bool bSearch_CaseSensitive = false;
 
+	// match the official Unicode character names too, e.g. "black right-pointing triangle"
+	UPROPERTY(Config, EditAnywhere)
+	bool bSearch_CharacterNames = true;
+
+	// list the most relevant matches of a text search above the grid, exact tags first, then word starts, names and other substrings
+	UPROPERTY(Config, EditAnywhere)
+	bool bSearch_BestMatches = true;
+
+	UPROPERTY(Config, EditAnywhere, meta=(EditCondition="bSearch_BestMatches", ClampMin=1, UIMax=128))
+	int32 Search_BestMatchesCount = 32;
+
+	// suggest the tags of the preset which start with the term being typed
+	UPROPERTY(Config, EditAnywhere)
+	bool bSearch_TagCompletions = true;
+
 	UPROPERTY(Config, EditAnywhere)
 	bool bRangeSelector_HideEmptyRanges = false;
 
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserPropertySets.h"
+
+THIRD_PARTY_INCLUDES_START
+#include <unicode/uchar.h>
+#include <unicode/uset.h>
+THIRD_PARTY_INCLUDES_END
+
+TMap<uint64, TSharedPtr<FUnicodeBrowserPropertySets::FRanges const>> FUnicodeBrowserPropertySets::Cache;
+
+TSharedPtr<FUnicodeBrowserPropertySets::FRanges const> FUnicodeBrowserPropertySets::Find(FStringView const Needle)
+{
+	int32 const Separator = Needle.Find(TEXT("="));
+	if (Separator == INDEX_NONE)
+		return nullptr;
+
+	FString const PropertyName(Needle.Left(Separator).TrimStartAndEnd());
+	FString const ValueName(Needle.RightChop(Separator + 1).TrimStartAndEnd());
+	if (PropertyName.IsEmpty() || ValueName.IsEmpty())
+		return nullptr;
+
+	UProperty Property = u_getPropertyEnum(TCHAR_TO_ANSI(*PropertyName));
+
+	// the mask variant of the general category also accepts groups like "L" or "Punctuation"
+	if (Property == UCHAR_GENERAL_CATEGORY)
+	{
+		Property = UCHAR_GENERAL_CATEGORY_MASK;
+	}
+
+	bool const bIntProperty = (Property >= UCHAR_BINARY_START && Property < UCHAR_BINARY_LIMIT)
+		|| (Property >= UCHAR_INT_START && Property < UCHAR_INT_LIMIT)
+		|| Property == UCHAR_GENERAL_CATEGORY_MASK;
+	if (!bIntProperty)
+		return nullptr;
+
+	int32 const Value = u_getPropertyValueEnum(Property, TCHAR_TO_ANSI(*ValueName));
+	if (Value == UCHAR_INVALID_CODE)
+		return nullptr;
+
+	uint64 const Key = static_cast<uint64>(Property) << 32 | static_cast<uint32>(Value);
+	if (TSharedPtr<FRanges const> const* Ranges = Cache.Find(Key))
+		return *Ranges;
+
+	TSharedPtr<FRanges const> Ranges = Build(Property, Value);
+	Cache.Add(Key, Ranges);
+	return Ranges;
+}
+
+TSharedPtr<FUnicodeBrowserPropertySets::FRanges const> FUnicodeBrowserPropertySets::Build(int32 const Property, int32 const Value)
+{
+	UErrorCode ErrorCode = U_ZERO_ERROR;
+	USet* Set = uset_openEmpty();
+	uset_applyIntPropertyValue(Set, static_cast<UProperty>(Property), Value, &ErrorCode);
+
+	TSharedRef<FRanges> Ranges = MakeShared<FRanges>();
+	if (U_SUCCESS(ErrorCode))
+	{
+		// ICU keeps the set as sorted ranges already, the items past the ranges are strings which we don't need
+		int32 const NumRanges = uset_getRangeCount(Set);
+		Ranges->Reserve(NumRanges);
+
+		for (int32 RangeIndex = 0; RangeIndex < NumRanges; ++RangeIndex)
+		{
+			UChar32 First, Last;
+			uset_getItem(Set, RangeIndex, &First, &Last, nullptr, 0, &ErrorCode);
+			Ranges->Emplace(First, Last);
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[FUnicodeBrowserPropertySets::Build] Failed to resolve the Unicode property set %d=%d: %hs"), Property, Value, u_errorName(ErrorCode));
+	}
+
+	uset_close(Set);
+	return Ranges;
+}
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * codepoints which share the value of a Unicode property, e.g. "gc=So", "Script=Greek" or "Emoji_Presentation=Yes"
+ * every set is resolved through ICU once per property value and kept as sorted, inclusive codepoint ranges
+ * a codepoint table turns a set into a bit mask with a single SetRange per range and block (see FUnicodeBrowserCodepointTable::SetRangeBits)
+ * not thread safe, only used by the search on the game thread
+ */
+class UNICODEBROWSER_API FUnicodeBrowserPropertySets
+{
+public:
+	using FRanges = TArray<FInt32Vector2>;
+
+	// parses "Property=Value", all property and value aliases known to ICU are accepted, loosely matched (case, spaces, underscores)
+	// returns nullptr if the needle isn't a query for a property which has integer values (binary, enumerated, general category)
+	static TSharedPtr<FRanges const> Find(FStringView Needle);
+
+private:
+	static TSharedPtr<FRanges const> Build(int32 Property, int32 Value);
+
+	static TMap<uint64, TSharedPtr<FRanges const>> Cache; // property << 32 | value => ranges
+};
@@ -0,0 +1,502 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserQuery.h"
+
+#include "Algo/AnyOf.h"
+#include "Algo/StableSort.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+#include "UnicodeBrowser/UnicodeBrowserCodepointTable.h"
+#include "UnicodeBrowser/UnicodeBrowserNameIndex.h"
+#include "UnicodeBrowser/UnicodeBrowserSearchSession.h"
+#include "UnicodeBrowser/UnicodeBrowserStatic.h"
+
+struct FUnicodeBrowserQuery::FToken
+{
+	enum class EType : uint8
+	{
+		Word,
+		Quoted,
+		And,
+		Or, // also a comma
+		Not,
+		Open,
+		Close
+	};
+
+	EType Type = EType::Word;
+	FString Text;
+};
+
+struct FUnicodeBrowserQuery::FEvaluateContext
+{
+	FUnicodeBrowserCodepointTable const& Table;
+	FUnicodeBrowserSearchSession* TagSession;
+	bool bSearchNames;
+	bool bCaseSensitive;
+	TFunctionRef<bool()> ShouldCancel;
+	FScores* Scores;
+};
+
+namespace UnicodeBrowser::Query
+{
+	// relevance of the sources of a text match, the tiers don't overlap and a codepoint keeps the best one
+	// the character itself beats any tag, names rank between tags with a word starting with the needle and other substrings
+	// (see FUnicodeBrowserTagIndex::ScoreEntry)
+	constexpr float CharacterScore = 5.0f;
+	constexpr float NameScore = 2.5f;
+}
+
+FUnicodeBrowserQuery FUnicodeBrowserQuery::Parse(FStringView const QueryText)
+{
+	FUnicodeBrowserQuery Query;
+	FStringView const Trimmed = QueryText.TrimStartAndEnd();
+	if (Trimmed.IsEmpty())
+		return Query;
+
+	// a single character is always a character search, even if it's "(", "," or a quote
+	if (Trimmed.Len() == 1)
+	{
+		Query.Root = Query.AddLeaf(FString(Trimmed), true);
+		return Query;
+	}
+
+	TArray<FToken> Tokens;
+	Tokenize(Trimmed, Tokens);
+
+	// stray closing parentheses end an expression, the parts around them are combined
+	TArray<int32> Parts;
+	int32 Position = 0;
+	while (Position < Tokens.Num())
+	{
+		int32 const Part = Query.ParseOr(Tokens, Position);
+		if (Part != INDEX_NONE)
+		{
+			Parts.Add(Part);
+		}
+
+		if (Position < Tokens.Num() && Tokens[Position].Type == FToken::EType::Close)
+		{
+			++Position;
+		}
+	}
+
+	Query.Root = Parts.Num() > 1 ? Query.AddNode(ENodeType::And, MoveTemp(Parts)) : Parts.IsEmpty() ? INDEX_NONE : Parts[0];
+	return Query;
+}
+
+bool FUnicodeBrowserQuery::HasTextTerms() const
+{
+	return Algo::AnyOf(Nodes, [](FNode const& Node) { return Node.Type == ENodeType::Text; });
+}
+
+TOptional<int32> FUnicodeBrowserQuery::GetSingleCodepoint() const
+{
+	if (IsEmpty() || Nodes[Root].Type != ENodeType::CodepointRange || Nodes[Root].Range.X != Nodes[Root].Range.Y)
+		return {};
+
+	return Nodes[Root].Range.X;
+}
+
+bool FUnicodeBrowserQuery::Evaluate(
+	FUnicodeBrowserCodepointTable const& Table,
+	FUnicodeBrowserSearchSession* const TagSession,
+	bool const bSearchNames,
+	bool const bCaseSensitive,
+	TFunctionRef<bool()> const ShouldCancel,
+	TBitArray<>& OutMask,
+	FScores* const OutScores
+) const
+{
+	if (IsEmpty())
+	{
+		OutMask.Init(true, Table.Num());
+		return true;
+	}
+
+	FEvaluateContext const Context{Table, TagSession, bSearchNames, bCaseSensitive, ShouldCancel, OutScores};
+	return EvaluateNode(Context, Root, OutMask);
+}
+
+void FUnicodeBrowserQuery::SelectBestMatches(FScores const& Scores, int32 const Count, TFunctionRef<bool(int32 Codepoint)> const Filter, TArray<int32>& OutCodepoints)
+{
+	if (Count <= 0)
+		return;
+
+	struct FMatch
+	{
+		float Score;
+		int32 Codepoint;
+	};
+
+	// the worst of the selected matches is on top of the heap
+	auto const IsWorse = [](FMatch const& A, FMatch const& B)
+	{
+		return A.Score < B.Score || (A.Score == B.Score && A.Codepoint > B.Codepoint);
+	};
+
+	TArray<FMatch> Heap;
+	Heap.Reserve(FMath::Min(Count, Scores.Num()));
+	for (auto const& [Codepoint, Score] : Scores)
+	{
+		FMatch const Match{Score, Codepoint};
+		if (Heap.Num() == Count && !IsWorse(Heap.HeapTop(), Match))
+			continue;
+
+		if (!Filter(Codepoint))
+			continue;
+
+		if (Heap.Num() == Count)
+		{
+			Heap.HeapPopDiscard(IsWorse);
+		}
+
+		Heap.HeapPush(Match, IsWorse);
+	}
+
+	Heap.Sort([&IsWorse](FMatch const& A, FMatch const& B) { return IsWorse(B, A); });
+
+	OutCodepoints.Reserve(OutCodepoints.Num() + Heap.Num());
+	for (FMatch const& Match : Heap)
+	{
+		OutCodepoints.Add(Match.Codepoint);
+	}
+}
+
+void FUnicodeBrowserQuery::Tokenize(FStringView const Text, TArray<FToken>& OutTokens)
+{
+	auto IsSeparator = [](TCHAR const Char)
+	{
+		return FChar::IsWhitespace(Char) || Char == TEXT('(') || Char == TEXT(')') || Char == TEXT(',') || Char == TEXT('"');
+	};
+
+	int32 Position = 0;
+	while (Position < Text.Len())
+	{
+		TCHAR const Char = Text[Position];
+		if (FChar::IsWhitespace(Char))
+		{
+			++Position;
+		}
+		else if (Char == TEXT('(') || Char == TEXT(')') || Char == TEXT(','))
+		{
+			OutTokens.Add({Char == TEXT('(') ? FToken::EType::Open : Char == TEXT(')') ? FToken::EType::Close : FToken::EType::Or});
+			++Position;
+		}
+		else if (Char == TEXT('"'))
+		{
+			// an unterminated quote runs until the end, the user is probably still typing
+			int32 End = Position + 1;
+			while (End < Text.Len() && Text[End] != TEXT('"'))
+			{
+				++End;
+			}
+
+			OutTokens.Add({FToken::EType::Quoted, FString(Text.Mid(Position + 1, End - Position - 1))});
+			Position = End + 1;
+		}
+		else
+		{
+			int32 End = Position;
+			while (End < Text.Len() && !IsSeparator(Text[End]))
+			{
+				++End;
+			}
+
+			FStringView const Word = Text.Mid(Position, End - Position);
+			FToken::EType const Type = Word.Equals(TEXT("AND"), ESearchCase::CaseSensitive)
+				? FToken::EType::And
+				: Word.Equals(TEXT("OR"), ESearchCase::CaseSensitive)
+				? FToken::EType::Or
+				: Word.Equals(TEXT("NOT"), ESearchCase::CaseSensitive)
+				? FToken::EType::Not
+				: FToken::EType::Word;
+
+			OutTokens.Add({Type, Type == FToken::EType::Word ? FString(Word) : FString()});
+			Position = End;
+		}
+	}
+}
+
+int32 FUnicodeBrowserQuery::ParseOr(TConstArrayView<FToken> const Tokens, int32& Position)
+{
+	TArray<int32> Children;
+	while (true)
+	{
+		int32 const Child = ParseAnd(Tokens, Position);
+		if (Child != INDEX_NONE)
+		{
+			Children.Add(Child);
+		}
+
+		if (Position >= Tokens.Num() || Tokens[Position].Type != FToken::EType::Or)
+			break;
+
+		++Position;
+	}
+
+	return Children.Num() > 1 ? AddNode(ENodeType::Or, MoveTemp(Children)) : Children.IsEmpty() ? INDEX_NONE : Children[0];
+}
+
+int32 FUnicodeBrowserQuery::ParseAnd(TConstArrayView<FToken> const Tokens, int32& Position)
+{
+	// terms next to each other are an implicit AND, e.g. "arrow NOT dashed"
+	TArray<int32> Children;
+	while (Position < Tokens.Num() && Tokens[Position].Type != FToken::EType::Or && Tokens[Position].Type != FToken::EType::Close)
+	{
+		if (Tokens[Position].Type == FToken::EType::And)
+		{
+			++Position;
+			continue;
+		}
+
+		int32 const Child = ParseUnary(Tokens, Position);
+		if (Child != INDEX_NONE)
+		{
+			Children.Add(Child);
+		}
+	}
+
+	return Children.Num() > 1 ? AddNode(ENodeType::And, MoveTemp(Children)) : Children.IsEmpty() ? INDEX_NONE : Children[0];
+}
+
+int32 FUnicodeBrowserQuery::ParseUnary(TConstArrayView<FToken> const Tokens, int32& Position)
+{
+	if (Tokens[Position].Type != FToken::EType::Not)
+		return ParsePrimary(Tokens, Position);
+
+	++Position;
+	if (Position >= Tokens.Num())
+		return INDEX_NONE;
+
+	int32 const Child = ParseUnary(Tokens, Position);
+	return Child != INDEX_NONE ? AddNode(ENodeType::Not, {Child}) : INDEX_NONE;
+}
+
+int32 FUnicodeBrowserQuery::ParsePrimary(TConstArrayView<FToken> const Tokens, int32& Position)
+{
+	FToken const& Token = Tokens[Position];
+	switch (Token.Type)
+	{
+	case FToken::EType::Open:
+		{
+			++Position;
+			int32 const Node = ParseOr(Tokens, Position);
+			if (Position < Tokens.Num() && Tokens[Position].Type == FToken::EType::Close)
+			{
+				++Position;
+			}
+
+			return Node;
+		}
+	case FToken::EType::Quoted:
+		++Position;
+		return Token.Text.IsEmpty() ? INDEX_NONE : AddLeaf(Token.Text, true);
+	case FToken::EType::Word:
+		{
+			// consecutive words form a single term, "black right-pointing triangle" is one needle
+			FString Text = Token.Text;
+			for (++Position; Position < Tokens.Num() && Tokens[Position].Type == FToken::EType::Word; ++Position)
+			{
+				Text += TEXT(' ');
+				Text += Tokens[Position].Text;
+			}
+
+			return AddLeaf(MoveTemp(Text), false);
+		}
+	default:
+		// an operator without an operand, it's consumed by the caller
+		return INDEX_NONE;
+	}
+}
+
+int32 FUnicodeBrowserQuery::AddLeaf(FString Text, bool const bQuoted)
+{
+	FNode& Node = Nodes.AddDefaulted_GetRef();
+	int32 First, Last;
+
+	// quoted text is always searched as text
+	if (!bQuoted && Text.Len() > 1 && UnicodeBrowser::ParseCodepointRange(Text, First, Last))
+	{
+		Node.Type = ENodeType::CodepointRange;
+		Node.Range = FInt32Vector2(First, Last);
+	}
+	else if (!bQuoted && (Node.PropertyRanges = FUnicodeBrowserPropertySets::Find(Text)).IsValid())
+	{
+		Node.Type = ENodeType::Property;
+	}
+	else
+	{
+		Node.Type = ENodeType::Text;
+	}
+
+	Node.Text = MoveTemp(Text);
+	return Nodes.Num() - 1;
+}
+
+int32 FUnicodeBrowserQuery::AddNode(ENodeType const Type, TArray<int32>&& Children)
+{
+	FNode& Node = Nodes.AddDefaulted_GetRef();
+	Node.Type = Type;
+	Node.Children = MoveTemp(Children);
+	return Nodes.Num() - 1;
+}
+
+int32 FUnicodeBrowserQuery::GetCost(int32 const NodeIndex) const
+{
+	FNode const& Node = Nodes[NodeIndex];
+	if (Node.Type == ENodeType::Text)
+		return 1;
+
+	int32 Cost = 0;
+	for (int32 const Child : Node.Children)
+	{
+		Cost = FMath::Max(Cost, GetCost(Child));
+	}
+
+	return Cost;
+}
+
+bool FUnicodeBrowserQuery::EvaluateNode(FEvaluateContext const& Context, int32 const NodeIndex, TBitArray<>& OutMask) const
+{
+	FNode const& Node = Nodes[NodeIndex];
+	int32 const NumRows = Context.Table.Num();
+
+	switch (Node.Type)
+	{
+	case ENodeType::Text:
+		OutMask.Init(false, NumRows);
+		return EvaluateText(Context, Node.Text, OutMask);
+
+	case ENodeType::CodepointRange:
+		OutMask.Init(false, NumRows);
+		Context.Table.SetRangeBits(OutMask, MakeArrayView(&Node.Range, 1));
+		return true;
+
+	case ENodeType::Property:
+		OutMask.Init(false, NumRows);
+		Context.Table.SetRangeBits(OutMask, *Node.PropertyRanges);
+		return true;
+
+	case ENodeType::Not:
+		{
+			// the matches of a negated term are excluded from the result, they don't add to the relevance
+			FEvaluateContext NegatedContext = Context;
+			NegatedContext.Scores = nullptr;
+			if (!EvaluateNode(NegatedContext, Node.Children[0], OutMask))
+				return false;
+		}
+
+		OutMask.BitwiseNOT();
+		return true;
+
+	case ENodeType::Or:
+		{
+			OutMask.Init(false, NumRows);
+			TBitArray<> ChildMask;
+			for (int32 const Child : Node.Children)
+			{
+				if (!EvaluateNode(Context, Child, ChildMask))
+					return false;
+
+				OutMask.CombineWithBitwiseOR(ChildMask, EBitwiseOperatorFlags::MaintainSize);
+			}
+
+			return true;
+		}
+
+	case ENodeType::And:
+		{
+			// the cheap terms narrow the result first, once nothing is left the index lookups are skipped
+			TArray<int32, TInlineAllocator<8>> Children(Node.Children);
+			Algo::StableSortBy(Children, [this](int32 const Child) { return GetCost(Child); });
+
+			OutMask.Init(true, NumRows);
+			TBitArray<> ChildMask;
+			for (int32 const Child : Children)
+			{
+				if (!EvaluateNode(Context, Child, ChildMask))
+					return false;
+
+				OutMask.CombineWithBitwiseAND(ChildMask, EBitwiseOperatorFlags::MaintainSize);
+				if (OutMask.Find(true) == INDEX_NONE)
+					break;
+			}
+
+			return true;
+		}
+	}
+
+	return true;
+}
+
+bool FUnicodeBrowserQuery::EvaluateText(FEvaluateContext const& Context, FString const& Text, TBitArray<>& OutMask) const
+{
+	if (Context.ShouldCancel())
+		return false;
+
+	// without a preset and with names disabled there is nothing to match longer text against, it doesn't filter then
+	if (Text.Len() > 1 && !Context.TagSession && !Context.bSearchNames)
+	{
+		OutMask.Init(true, Context.Table.Num());
+		return true;
+	}
+
+	FUnicodeBrowserCodepointSet Codepoints;
+
+	// the best match of every codepoint for this leaf, the leaves of a query add up
+	FScores LeafScores;
+	FScores* const Scores = Context.Scores ? &LeafScores : nullptr;
+
+	if (Text.Len() == 1)
+	{
+		TCHAR const Character = Text[0];
+		Codepoints.Add(Character);
+
+		if (!Context.bCaseSensitive)
+		{
+			Codepoints.Add(FChar::ToUpper(Character));
+			Codepoints.Add(FChar::ToLower(Character));
+		}
+
+		if (Scores)
+		{
+			Codepoints.ForEach([Scores](int32 const Codepoint) { Scores->Add(Codepoint, UnicodeBrowser::Query::CharacterScore); });
+		}
+	}
+
+	if (Context.TagSession)
+	{
+		Context.TagSession->FindCodepoints(Text, Codepoints, Scores);
+	}
+
+	// single letters would match a word of almost every name
+	if (Context.bSearchNames && Text.Len() > 1)
+	{
+		if (Scores)
+		{
+			FUnicodeBrowserCodepointSet NameCodepoints;
+			FUnicodeBrowserNameIndex::Get().FindCodepoints(Text, NameCodepoints);
+			NameCodepoints.ForEach(
+				[Scores](int32 const Codepoint)
+				{
+					float& Score = Scores->FindOrAdd(Codepoint);
+					Score = FMath::Max(Score, UnicodeBrowser::Query::NameScore);
+				}
+			);
+			Codepoints.Append(NameCodepoints);
+		}
+		else
+		{
+			FUnicodeBrowserNameIndex::Get().FindCodepoints(Text, Codepoints);
+		}
+	}
+
+	for (auto const& [Codepoint, Score] : LeafScores)
+	{
+		Context.Scores->FindOrAdd(Codepoint) += Score;
+	}
+
+	Context.Table.SetCodepointBits(OutMask, Codepoints);
+	return true;
+}
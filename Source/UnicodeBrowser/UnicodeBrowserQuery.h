@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UnicodeBrowser/UnicodeBrowserPropertySets.h"
+
+class FUnicodeBrowserCodepointTable;
+class FUnicodeBrowserSearchSession;
+
+/**
+ * expression tree of a search query
+ *   arrow AND double NOT dashed     words next to each other form a single term, operators must be uppercase
+ *   "not equal to", (left OR right)  quotes keep operators as text, parentheses group
+ *   arrow, gc=So, U+2190-U+21FF     a comma is an OR, terms may be codepoint literals or Unicode properties
+ * every leaf resolves to a bit mask in table space, so the operators are word-wise bit operations
+ */
+class UNICODEBROWSER_API FUnicodeBrowserQuery
+{
+public:
+	enum class ENodeType : uint8
+	{
+		Text, // matched against the character itself, tags and names
+		CodepointRange,
+		Property,
+		And,
+		Or,
+		Not
+	};
+
+	struct FNode
+	{
+		ENodeType Type = ENodeType::Text;
+		FString Text;
+		FInt32Vector2 Range = FInt32Vector2::ZeroValue; // inclusive, CodepointRange only
+		TSharedPtr<FUnicodeBrowserPropertySets::FRanges const> PropertyRanges;
+		TArray<int32> Children;
+	};
+
+	// codepoint => relevance, the best match within a text leaf summed over all text leaves which aren't negated
+	using FScores = TMap<int32, float>;
+
+	static FUnicodeBrowserQuery Parse(FStringView Query);
+
+	bool IsEmpty() const { return Root == INDEX_NONE; }
+
+	// text leaves need the tag and name indices, everything else is resolved from the table alone
+	bool HasTextTerms() const;
+
+	// the query is a lookup of a single codepoint
+	TOptional<int32> GetSingleCodepoint() const;
+
+	// evaluates the query into one bit per table index, returns false if it got cancelled
+	// the tag session may be null if no preset applies, the table is only read so this may run on any thread
+	// text longer than a character matches everything if there is neither a tag session nor a name search
+	// scores are only gathered if requested, ranking them is left to SelectBestMatches
+	bool Evaluate(
+		FUnicodeBrowserCodepointTable const& Table,
+		FUnicodeBrowserSearchSession* TagSession,
+		bool bSearchNames,
+		bool bCaseSensitive,
+		TFunctionRef<bool()> ShouldCancel,
+		TBitArray<>& OutMask,
+		FScores* OutScores = nullptr
+	) const;
+
+	// the codepoints with the highest scores which pass the filter, best first, ties in codepoint order
+	// a bounded heap keeps the selection at O(n log Count) no matter how many codepoints matched
+	static void SelectBestMatches(FScores const& Scores, int32 Count, TFunctionRef<bool(int32 Codepoint)> Filter, TArray<int32>& OutCodepoints);
+
+private:
+	struct FToken;
+	struct FEvaluateContext;
+
+	static void Tokenize(FStringView Text, TArray<FToken>& OutTokens);
+
+	// recursive descent, OR binds weaker than AND, which binds weaker than NOT
+	int32 ParseOr(TConstArrayView<FToken> Tokens, int32& Position);
+	int32 ParseAnd(TConstArrayView<FToken> Tokens, int32& Position);
+	int32 ParseUnary(TConstArrayView<FToken> Tokens, int32& Position);
+	int32 ParsePrimary(TConstArrayView<FToken> Tokens, int32& Position);
+
+	// codepoint literals and properties are recognized here, quoted text is always a text leaf
+	int32 AddLeaf(FString Text, bool bQuoted);
+	int32 AddNode(ENodeType Type, TArray<int32>&& Children);
+
+	// leaves which only read the table come first, so an empty intersection skips the index lookups
+	int32 GetCost(int32 NodeIndex) const;
+
+	bool EvaluateNode(FEvaluateContext const& Context, int32 NodeIndex, TBitArray<>& OutMask) const;
+	bool EvaluateText(FEvaluateContext const& Context, FString const& Text, TBitArray<>& OutMask) const;
+
+	TArray<FNode> Nodes;
+	int32 Root = INDEX_NONE;
+};
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserSearchSession.h"
+
+#include "UnicodeBrowser/UnicodeBrowserCodepointSet.h"
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+
+void FUnicodeBrowserSearchSession::Begin(TSharedRef<FUnicodeBrowserTagIndex const> const& IndexIn)
+{
+	// the index gets rebuilt whenever the preset or any of its parents changed, previous results don't apply to it
+	if (LastIndex.Pin() != IndexIn)
+	{
+		LastIndex.Reset();
+		LastResults.Reset();
+	}
+
+	Index = IndexIn;
+	Results.Reset();
+}
+
+void FUnicodeBrowserSearchSession::FindCodepoints(FStringView const Needle, FUnicodeBrowserCodepointSet& OutCodepoints, TMap<int32, float>* OutScores)
+{
+	check(Index.IsValid());
+
+	FString FoldedNeedle = FUnicodeBrowserTagIndex::Fold(Needle.TrimStartAndEnd());
+	if (FoldedNeedle.IsEmpty())
+		return;
+
+	FNeedleResult* Result = Results.Find(FoldedNeedle);
+	if (!Result)
+	{
+		// the smallest previous result of a needle which this needle contains
+		TArray<int32> const* Candidates = nullptr;
+		for (auto const& [LastNeedle, LastResult] : LastResults)
+		{
+			if (FoldedNeedle.Contains(LastNeedle, ESearchCase::CaseSensitive) && (!Candidates || LastResult.Entries.Num() < Candidates->Num()))
+			{
+				Candidates = &LastResult.Entries;
+			}
+		}
+
+		FNeedleResult NewResult;
+		if (Candidates)
+		{
+			Index->FilterEntries(*Candidates, FoldedNeedle, NewResult.Entries);
+		}
+		else
+		{
+			Index->FindEntries(FoldedNeedle, NewResult.Entries);
+		}
+
+		Result = &Results.Add(FoldedNeedle, MoveTemp(NewResult));
+	}
+
+	for (int32 const Entry : Result->Entries)
+	{
+		OutCodepoints.Add(Index->GetCodepoint(Entry));
+	}
+
+	if (OutScores)
+	{
+		if (Result->Scores.Num() != Result->Entries.Num())
+		{
+			Result->Scores.Reset(Result->Entries.Num());
+			for (int32 const Entry : Result->Entries)
+			{
+				Result->Scores.Add(Index->ScoreEntry(Entry, FoldedNeedle));
+			}
+		}
+
+		for (int32 EntryIndex = 0; EntryIndex < Result->Entries.Num(); ++EntryIndex)
+		{
+			float& Score = OutScores->FindOrAdd(Index->GetCodepoint(Result->Entries[EntryIndex]));
+			Score = FMath::Max(Score, Result->Scores[EntryIndex]);
+		}
+	}
+}
+
+void FUnicodeBrowserSearchSession::Commit()
+{
+	LastIndex = Index;
+	LastResults = MoveTemp(Results);
+	Results.Reset();
+	Index.Reset();
+}
+
+void FUnicodeBrowserSearchSession::Reset()
+{
+	Index.Reset();
+	Results.Reset();
+	LastIndex.Reset();
+	LastResults.Reset();
+}
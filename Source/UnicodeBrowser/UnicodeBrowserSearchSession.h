@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FUnicodeBrowserCodepointSet;
+class FUnicodeBrowserTagIndex;
+
+/**
+ * tag search across consecutive queries of the search bar
+ * if a needle contains a needle of the previous query (e.g. "arr" => "arrow"), its matches can only be a subset,
+ * so only the previous matches are checked again, other needles run a full query against the tag index
+ * queries may run on a worker thread, but only one query at a time
+ */
+class UNICODEBROWSER_API FUnicodeBrowserSearchSession
+{
+public:
+	// starts a query against the index, the needles of the previous query remain available for refinement
+	void Begin(TSharedRef<FUnicodeBrowserTagIndex const> const& Index);
+
+	// adds the codepoints of all entries with a tag containing the needle (case-insensitive)
+	// if scores are requested, the score of a codepoint is raised to the relevance of its best match (see FUnicodeBrowserTagIndex::ScoreEntry)
+	void FindCodepoints(FStringView Needle, FUnicodeBrowserCodepointSet& OutCodepoints, TMap<int32, float>* OutScores = nullptr);
+
+	// the finished query becomes the base for refinement, a cancelled query is simply never committed
+	void Commit();
+
+	void Reset();
+
+private:
+	struct FNeedleResult
+	{
+		TArray<int32> Entries;
+		TArray<float> Scores; // parallel to Entries, only scored once a query asks for it
+	};
+
+	TSharedPtr<FUnicodeBrowserTagIndex const> Index;
+	TMap<FString, FNeedleResult> Results; // case folded needle => matching entries, of the running query
+
+	TWeakPtr<FUnicodeBrowserTagIndex const> LastIndex;
+	TMap<FString, FNeedleResult> LastResults;
+};
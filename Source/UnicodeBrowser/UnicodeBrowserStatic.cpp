@@ -2,11 +2,46 @@
 
 #include "Fonts/UnicodeBlockRange.h"
 
+#include "Misc/Parse.h"
+
+#include "UnicodeBrowser/UnicodeBrowserNameIndex.h"
+
 THIRD_PARTY_INCLUDES_START
 #include <unicode/uchar.h>
-#include <unicode/unistr.h>
 THIRD_PARTY_INCLUDES_END
 
+namespace UnicodeBrowser
+{
+	// consumes a hexadecimal codepoint from the start of the text
+	static bool ParseCodepointLiteral(FStringView& Text, bool const bRequirePrefix, int32& OutCodepoint)
+	{
+		if (Text.StartsWith(TEXT("U+"), ESearchCase::IgnoreCase) || Text.StartsWith(TEXT("0x"), ESearchCase::IgnoreCase))
+		{
+			Text.RightChopInline(2);
+		}
+		else if (bRequirePrefix)
+		{
+			return false;
+		}
+
+		int32 NumDigits = 0;
+		int32 Codepoint = 0;
+		while (NumDigits < Text.Len() && FChar::IsHexDigit(Text[NumDigits]))
+		{
+			Codepoint = Codepoint * 16 + FParse::HexDigit(Text[NumDigits]);
+			if (++NumDigits > 6)
+				return false;
+		}
+
+		if (NumDigits == 0 || Codepoint > 0x10FFFF)
+			return false;
+
+		Text.RightChopInline(NumDigits);
+		OutCodepoint = Codepoint;
+		return true;
+	}
+}
+
 TOptional<EUnicodeBlockRange> UnicodeBrowser::GetUnicodeBlockRangeFromChar(int32 const CharCode)
 {
 	for (auto const& BlockRange : FUnicodeBlockRange::GetUnicodeBlockRanges())
@@ -47,21 +82,58 @@ int32 UnicodeBrowser::GetRangeIndex(EUnicodeBlockRange BlockRange)
 
 FString UnicodeBrowser::GetUnicodeCharacterName(int32 const CharCode)
 {
-	UChar32 const uChar = static_cast<UChar32>(CharCode);
-	UErrorCode errorCode = U_ZERO_ERROR;
-	char* name = new char[256];
-
-	// Get the Unicode character name using ICU
-	int32_t const length = u_charName(uChar, U_CHAR_NAME_ALIAS, name, 256, &errorCode);
-	FString Result;
-	if (U_SUCCESS(errorCode) && length > 0)
+	// control characters have no name, but an alias like "NULL"
+	FUnicodeBrowserNameIndex const& NameIndex = FUnicodeBrowserNameIndex::Get();
+	FString Name = NameIndex.GetName(CharCode);
+	if (Name.IsEmpty())
 	{
-		Result = FString(name);
+		Name = NameIndex.GetAlias(CharCode);
 	}
-	else
+
+	// unnamed codepoints (unassigned, private use, surrogates) show the ICU status, like before the name index
+	if (Name.IsEmpty())
 	{
-		Result = FString::Printf(TEXT("Unknown %hs"), u_errorName(errorCode));
+		char Buffer[256];
+		UErrorCode ErrorCode = U_ZERO_ERROR;
+		u_charName(static_cast<UChar32>(CharCode), U_CHAR_NAME_ALIAS, Buffer, UE_ARRAY_COUNT(Buffer), &ErrorCode);
+		Name = FString::Printf(TEXT("Unknown %hs"), u_errorName(ErrorCode));
 	}
-	delete[] name;
-	return Result;
+
+	return Name;
+}
+
+bool UnicodeBrowser::ParseCodepointRange(FStringView Needle, int32& OutFirst, int32& OutLast)
+{
+	Needle = Needle.TrimStartAndEnd();
+
+	int32 First;
+	if (!ParseCodepointLiteral(Needle, true, First))
+		return false;
+
+	// the end of a range doesn't need a prefix, "U+2190-21FF" is fine
+	int32 Last = First;
+	Needle = Needle.TrimStart();
+	if (!Needle.IsEmpty())
+	{
+		if (Needle.StartsWith(TEXT("..")))
+		{
+			Needle.RightChopInline(2);
+		}
+		else if (Needle.StartsWith(TEXT('-')))
+		{
+			Needle.RightChopInline(1);
+		}
+		else
+		{
+			return false;
+		}
+
+		Needle = Needle.TrimStart();
+		if (!ParseCodepointLiteral(Needle, false, Last) || !Needle.IsEmpty())
+			return false;
+	}
+
+	OutFirst = FMath::Min(First, Last);
+	OutLast = FMath::Max(First, Last);
+	return true;
 }
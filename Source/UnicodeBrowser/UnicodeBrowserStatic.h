@@ -11,10 +11,14 @@ namespace UnicodeBrowser
        static TConstArrayView<FUnicodeBlockRange const> Ranges; // all known Unicode ranges
        TConstArrayView<FUnicodeBlockRange const> GetUnicodeBlockRanges();
 
-       static FString GetUnicodeCharacterName(int32 CharCode);
+       // the official Unicode name, or its alias if it has none, "Unknown <ICU status>" for unnamed codepoints
+       FString GetUnicodeCharacterName(int32 CharCode);
 
        int32 GetRangeIndex(EUnicodeBlockRange BlockRange);
 
+       // parses a codepoint literal ("U+1F600", "0x1F600") or an inclusive range ("U+2190-U+21FF", "0x2190..21FF")
+       bool ParseCodepointRange(FStringView Needle, int32& OutFirst, int32& OutLast);
+
        static TArray<EUnicodeBlockRange> SymbolRanges = {
                EUnicodeBlockRange::Arrows,
                EUnicodeBlockRange::BlockElements,
@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+#include "String/Find.h"
+
+#include "UnicodeBrowser/DataAsset_FontTags.h"
+#include "UnicodeBrowser/UnicodeBrowserTagPack.h"
+
+FUnicodeBrowserTagIndex::FUnicodeBrowserTagIndex(FUnicodeCharacterTagTable const& Table)
+{
+	Build(Table, nullptr);
+}
+
+FUnicodeBrowserTagIndex::FUnicodeBrowserTagIndex(FUnicodeBrowserTagIndex const& Previous, FUnicodeCharacterTagTable const& Table)
+{
+	check(Previous.NumTags() <= Table.NumTags());
+	Build(Table, &Previous.GetView());
+}
+
+FUnicodeBrowserTagIndex::FUnicodeBrowserTagIndex(TSharedRef<FUnicodeBrowserTagPack const> const& PackIn)
+	: Pack(PackIn)
+	, Data(PackIn->GetIndexView())
+{
+}
+
+void FUnicodeBrowserTagIndex::Build(FUnicodeCharacterTagTable const& Table, FView const* Previous)
+{
+	Storage.EntryCodepoints = Table.Codepoints;
+	Storage.EntryTagOffsets = Table.TagOffsets;
+	Storage.EntryTagIds = Table.TagIds;
+	if (Storage.EntryTagOffsets.IsEmpty())
+	{
+		Storage.EntryTagOffsets.Add(0);
+	}
+
+	int32 const NumTags = Table.NumTags();
+	Storage.FoldedOffsets.Reserve(NumTags + 1);
+	if (Previous)
+	{
+		Storage.FoldedChars.Append(Previous->FoldedChars.GetData(), Previous->FoldedChars.Num());
+		Storage.FoldedOffsets.Append(Previous->FoldedOffsets.GetData(), Previous->FoldedOffsets.Num());
+	}
+	else
+	{
+		Storage.FoldedOffsets.Add(0);
+	}
+
+	// the trigrams of the tags which aren't indexed yet
+	TArray<TPair<uint64, int32>> Grams;
+	for (int32 TagId = Storage.FoldedOffsets.Num() - 1; TagId < NumTags; ++TagId)
+	{
+		FString const FoldedTag = Fold(Table.Tags[TagId]);
+		Storage.FoldedChars.Append(*FoldedTag, FoldedTag.Len());
+		Storage.FoldedOffsets.Add(Storage.FoldedChars.Num());
+
+		for (int32 Position = 0; Position + GramLength <= FoldedTag.Len(); ++Position)
+		{
+			Grams.Emplace(PackTrigram(&FoldedTag[Position]), TagId);
+		}
+	}
+
+	Grams.Sort([](TPair<uint64, int32> const& A, TPair<uint64, int32> const& B) { return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value; });
+
+	// merge with the previous postings, the new tag ids are larger than the previous ones, so they go behind the previous list of a trigram
+	TConstArrayView<uint64> const PreviousKeys = Previous ? Previous->PostingKeys : TConstArrayView<uint64>();
+	int32 PreviousKey = 0;
+	int32 Gram = 0;
+	Storage.PostingOffsets.Add(0);
+	while (PreviousKey < PreviousKeys.Num() || Gram < Grams.Num())
+	{
+		bool const bPreviousFirst = Gram == Grams.Num() || (PreviousKey < PreviousKeys.Num() && PreviousKeys[PreviousKey] <= Grams[Gram].Key);
+		uint64 const Key = bPreviousFirst ? PreviousKeys[PreviousKey] : Grams[Gram].Key;
+
+		if (PreviousKey < PreviousKeys.Num() && PreviousKeys[PreviousKey] == Key)
+		{
+			int32 const First = Previous->PostingOffsets[PreviousKey];
+			Storage.PostingTagIds.Append(Previous->PostingTagIds.GetData() + First, Previous->PostingOffsets[PreviousKey + 1] - First);
+			++PreviousKey;
+		}
+
+		// a tag which contains the trigram more than once is listed once
+		for (; Gram < Grams.Num() && Grams[Gram].Key == Key; ++Gram)
+		{
+			if (Storage.PostingTagIds.Num() == Storage.PostingOffsets.Last() || Storage.PostingTagIds.Last() != Grams[Gram].Value)
+			{
+				Storage.PostingTagIds.Add(Grams[Gram].Value);
+			}
+		}
+
+		Storage.PostingKeys.Add(Key);
+		Storage.PostingOffsets.Add(Storage.PostingTagIds.Num());
+	}
+
+	// invert the entry => tags lists, entries are visited in order, so the entries of every tag stay sorted
+	Storage.TagEntryOffsets.SetNumZeroed(NumTags + 1);
+	for (int32 const TagId : Storage.EntryTagIds)
+	{
+		++Storage.TagEntryOffsets[TagId + 1];
+	}
+
+	for (int32 TagId = 0; TagId < NumTags; ++TagId)
+	{
+		Storage.TagEntryOffsets[TagId + 1] += Storage.TagEntryOffsets[TagId];
+	}
+
+	TArray<int32> TagFill(Storage.TagEntryOffsets.GetData(), NumTags);
+	Storage.TagEntries.SetNumUninitialized(Storage.EntryTagIds.Num());
+	for (int32 Entry = 0; Entry < Storage.EntryCodepoints.Num(); ++Entry)
+	{
+		for (int32 Tag = Storage.EntryTagOffsets[Entry]; Tag < Storage.EntryTagOffsets[Entry + 1]; ++Tag)
+		{
+			Storage.TagEntries[TagFill[Storage.EntryTagIds[Tag]]++] = Entry;
+		}
+	}
+
+	Data.FoldedChars = Storage.FoldedChars;
+	Data.FoldedOffsets = Storage.FoldedOffsets;
+	Data.EntryCodepoints = Storage.EntryCodepoints;
+	Data.EntryTagOffsets = Storage.EntryTagOffsets;
+	Data.EntryTagIds = Storage.EntryTagIds;
+	Data.TagEntryOffsets = Storage.TagEntryOffsets;
+	Data.TagEntries = Storage.TagEntries;
+	Data.PostingKeys = Storage.PostingKeys;
+	Data.PostingOffsets = Storage.PostingOffsets;
+	Data.PostingTagIds = Storage.PostingTagIds;
+}
+
+void FUnicodeBrowserTagIndex::FindEntries(FStringView const Needle, TArray<int32>& OutEntries) const
+{
+	FString const FoldedNeedle = Fold(Needle);
+	if (FoldedNeedle.IsEmpty())
+		return;
+
+	TBitArray<> TagMask;
+	FindTags(FoldedNeedle, TagMask);
+
+	// an entry may have several matching tags, the mask keeps the entries unique and sorted
+	TBitArray<> EntryMask(false, NumEntries());
+	for (TConstSetBitIterator<> It(TagMask); It; ++It)
+	{
+		for (int32 const Entry : Data.GetTagEntries(It.GetIndex()))
+		{
+			if (Data.IsValidEntry(Entry))
+			{
+				EntryMask[Entry] = true;
+			}
+		}
+	}
+
+	for (TConstSetBitIterator<> It(EntryMask); It; ++It)
+	{
+		OutEntries.Add(It.GetIndex());
+	}
+}
+
+void FUnicodeBrowserTagIndex::FilterEntries(TConstArrayView<int32> const Candidates, FStringView const Needle, TArray<int32>& OutEntries) const
+{
+	FString const FoldedNeedle = Fold(Needle);
+	if (FoldedNeedle.IsEmpty())
+		return;
+
+	TBitArray<> TagMask;
+	FindTags(FoldedNeedle, TagMask);
+
+	for (int32 const Candidate : Candidates)
+	{
+		for (int32 const TagId : Data.GetEntryTagIds(Candidate))
+		{
+			if (Data.IsValidTag(TagId) && TagMask[TagId])
+			{
+				OutEntries.Add(Candidate);
+				break;
+			}
+		}
+	}
+}
+
+float FUnicodeBrowserTagIndex::ScoreEntry(int32 const Entry, FString const& FoldedNeedle) const
+{
+	float BestScore = 0.0f;
+	for (int32 const TagId : Data.GetEntryTagIds(Entry))
+	{
+		if (!Data.IsValidTag(TagId))
+			continue;
+
+		FStringView const FoldedTag = GetFoldedTag(TagId);
+
+		float KindScore = 0.0f;
+		if (FoldedTag.Equals(FoldedNeedle, ESearchCase::CaseSensitive))
+		{
+			KindScore = 4.0f;
+		}
+		else
+		{
+			for (int32 Position = UE::String::FindFirst(FoldedTag, FoldedNeedle, ESearchCase::CaseSensitive); Position != INDEX_NONE;)
+			{
+				if (Position == 0 || !FChar::IsAlnum(FoldedTag[Position - 1]))
+				{
+					KindScore = 3.0f;
+					break;
+				}
+
+				KindScore = 1.0f;
+
+				int32 const Next = UE::String::FindFirst(FoldedTag.RightChop(Position + 1), FoldedNeedle, ESearchCase::CaseSensitive);
+				Position = Next == INDEX_NONE ? INDEX_NONE : Position + 1 + Next;
+			}
+		}
+
+		if (KindScore > 0.0f)
+		{
+			// the frequency only orders matches of the same kind, it stays below 1
+			float const FrequencyScore = 1.0f / (1.0f + FMath::Log2(static_cast<float>(FMath::Max(NumTagEntries(TagId), 1))));
+			BestScore = FMath::Max(BestScore, KindScore + FrequencyScore * 0.99f);
+		}
+	}
+
+	return BestScore;
+}
+
+SIZE_T FUnicodeBrowserTagIndex::GetAllocatedSize() const
+{
+	// a mapped index isn't allocated, the pages of the pack belong to the file cache
+	return Storage.FoldedChars.GetAllocatedSize() + Storage.FoldedOffsets.GetAllocatedSize() + Storage.EntryCodepoints.GetAllocatedSize()
+		+ Storage.EntryTagOffsets.GetAllocatedSize() + Storage.EntryTagIds.GetAllocatedSize() + Storage.TagEntryOffsets.GetAllocatedSize()
+		+ Storage.TagEntries.GetAllocatedSize() + Storage.PostingKeys.GetAllocatedSize() + Storage.PostingOffsets.GetAllocatedSize()
+		+ Storage.PostingTagIds.GetAllocatedSize();
+}
+
+FString FUnicodeBrowserTagIndex::Fold(FStringView const Text)
+{
+	return FString(Text).ToLower();
+}
+
+uint64 FUnicodeBrowserTagIndex::PackTrigram(TCHAR const* Chars)
+{
+	return (static_cast<uint64>(Chars[0]) & 0x1FFFFF) << 42 | (static_cast<uint64>(Chars[1]) & 0x1FFFFF) << 21 | (static_cast<uint64>(Chars[2]) & 0x1FFFFF);
+}
+
+void FUnicodeBrowserTagIndex::FindTags(FString const& FoldedNeedle, TBitArray<>& OutTagMask) const
+{
+	OutTagMask.Init(false, NumTags());
+
+	// needles which are shorter than a trigram match too many tags for an index to pay off, every distinct tag is checked once
+	if (FoldedNeedle.Len() < GramLength)
+	{
+		for (int32 TagId = 0; TagId < NumTags(); ++TagId)
+		{
+			if (UE::String::FindFirst(GetFoldedTag(TagId), FoldedNeedle, ESearchCase::CaseSensitive) != INDEX_NONE)
+			{
+				OutTagMask[TagId] = true;
+			}
+		}
+
+		return;
+	}
+
+	TArray<TConstArrayView<int32>, TInlineAllocator<16>> Lists;
+	for (int32 Position = 0; Position + GramLength <= FoldedNeedle.Len(); ++Position)
+	{
+		int32 const Key = Algo::BinarySearch(Data.PostingKeys, PackTrigram(&FoldedNeedle[Position]));
+		if (Key == INDEX_NONE)
+			return;
+
+		// a trigram which occurs more than once in the needle only needs to be intersected once
+		TConstArrayView<int32> const Posting = FView::GetList(Data.PostingOffsets, Data.PostingTagIds, Key);
+		if (!Lists.ContainsByPredicate([&Posting](TConstArrayView<int32> const List) { return List.GetData() == Posting.GetData(); }))
+		{
+			Lists.Add(Posting);
+		}
+	}
+
+	// intersect starting with the shortest list, every step can only shrink the candidates
+	Lists.Sort([](TConstArrayView<int32> const A, TConstArrayView<int32> const B) { return A.Num() < B.Num(); });
+
+	TArray<int32> Candidates(Lists[0].GetData(), Lists[0].Num());
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && !Candidates.IsEmpty(); ++ListIndex)
+	{
+		TConstArrayView<int32> const List = Lists[ListIndex];
+		int32 NumKept = 0;
+		int32 ListPosition = 0;
+		for (int32 const Candidate : Candidates)
+		{
+			while (ListPosition < List.Num() && List[ListPosition] < Candidate)
+			{
+				++ListPosition;
+			}
+
+			if (ListPosition < List.Num() && List[ListPosition] == Candidate)
+			{
+				Candidates[NumKept++] = Candidate;
+			}
+		}
+
+		Candidates.SetNum(NumKept);
+	}
+
+	// the trigrams may be spread over different positions of the tag, so the candidates still need a substring check
+	for (int32 const Candidate : Candidates)
+	{
+		if (Data.IsValidTag(Candidate) && (FoldedNeedle.Len() == GramLength || UE::String::FindFirst(GetFoldedTag(Candidate), FoldedNeedle, ESearchCase::CaseSensitive) != INDEX_NONE))
+		{
+			OutTagMask[Candidate] = true;
+		}
+	}
+}
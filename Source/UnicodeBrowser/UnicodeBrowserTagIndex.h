@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FUnicodeBrowserTagPack;
+struct FUnicodeCharacterTagTable;
+
+/**
+ * substring index over the interned tags of a font tags preset
+ * every distinct tag is case folded once, every trigram of a tag maps to a sorted posting list of the tag ids which contain it
+ * a query intersects the posting lists of the trigrams of the needle and only verifies the remaining tags,
+ * the entries of the matching tags are then collected from an inverted list, so no entry is ever compared by string
+ * all data is stored in flat arrays, so a tag pack can store the index as is and queries run on the mapped file
+ * the index is immutable once built and copies everything it needs, so queries may run on any thread
+ */
+class UNICODEBROWSER_API FUnicodeBrowserTagIndex
+{
+public:
+	// the arrays which make up an index, they point either into the storage of the index or into a mapped tag pack
+	struct FView
+	{
+		TConstArrayView<TCHAR> FoldedChars; // the case folded tags back to back
+		TConstArrayView<int32> FoldedOffsets; // tag id t is FoldedChars[FoldedOffsets[t]] to FoldedChars[FoldedOffsets[t + 1] - 1]
+		TConstArrayView<int32> EntryCodepoints;
+		TConstArrayView<int32> EntryTagOffsets; // the tag ids of entry i are EntryTagIds[EntryTagOffsets[i]] to EntryTagIds[EntryTagOffsets[i + 1] - 1]
+		TConstArrayView<int32> EntryTagIds;
+		TConstArrayView<int32> TagEntryOffsets; // the inverse, the sorted entries of tag t are TagEntries[TagEntryOffsets[t]] to TagEntries[TagEntryOffsets[t + 1] - 1]
+		TConstArrayView<int32> TagEntries;
+		TConstArrayView<uint64> PostingKeys; // sorted trigrams
+		TConstArrayView<int32> PostingOffsets; // the sorted tag ids of trigram k are PostingTagIds[PostingOffsets[k]] to PostingTagIds[PostingOffsets[k + 1] - 1]
+		TConstArrayView<int32> PostingTagIds;
+
+		// the values of list i of a section which is split by offsets, empty if its offsets are out of order or out of range
+		// a tag pack only gets the sizes of its sections validated, so every list is taken through here instead of trusting the mapped offsets
+		template <typename T>
+		static TConstArrayView<T> GetList(TConstArrayView<int32> const Offsets, TConstArrayView<T> const Values, int32 const List)
+		{
+			int32 const First = Offsets[List];
+			int32 const Last = Offsets[List + 1];
+			return First >= 0 && First <= Last && Last <= Values.Num() ? Values.Mid(First, Last - First) : TConstArrayView<T>();
+		}
+
+		// the ids read from a list may be out of range just the same, they are skipped
+		bool IsValidTag(int32 const TagId) const { return TagId >= 0 && TagId < FoldedOffsets.Num() - 1; }
+		bool IsValidEntry(int32 const Entry) const { return Entry >= 0 && Entry < EntryCodepoints.Num(); }
+
+		TConstArrayView<int32> GetEntryTagIds(int32 const Entry) const { return GetList(EntryTagOffsets, EntryTagIds, Entry); }
+		TConstArrayView<int32> GetTagEntries(int32 const TagId) const { return GetList(TagEntryOffsets, TagEntries, TagId); }
+	};
+
+	explicit FUnicodeBrowserTagIndex(FUnicodeCharacterTagTable const& Table);
+
+	// the index of a table which only got tags appended since the previous index was built (a patched table),
+	// the folded tags and trigram postings of the previous index are reused, only the new tags get indexed
+	FUnicodeBrowserTagIndex(FUnicodeBrowserTagIndex const& Previous, FUnicodeCharacterTagTable const& Table);
+
+	// the index which a tag pack stores, nothing gets built, the pages of the pack are only read once a query touches them
+	explicit FUnicodeBrowserTagIndex(TSharedRef<FUnicodeBrowserTagPack const> const& Pack);
+
+	UE_NONCOPYABLE(FUnicodeBrowserTagIndex);
+
+	// appends the indices of all entries with a tag containing the needle (case-insensitive), sorted ascending
+	void FindEntries(FStringView Needle, TArray<int32>& OutEntries) const;
+
+	// appends all candidates with a tag containing the needle, used to refine a previous result
+	void FilterEntries(TConstArrayView<int32> Candidates, FStringView Needle, TArray<int32>& OutEntries) const;
+
+	// relevance of the best tag of the entry for the folded needle, 0 if no tag contains it
+	// an exact tag beats a tag with a word starting with the needle, which beats any other substring
+	// within the same kind of match, tags shared by fewer entries score higher
+	// an exact tag scores 4 to 5, a word start 3 to 4 and any other substring 1 to 2, the gap is left for name matches
+	float ScoreEntry(int32 Entry, FString const& FoldedNeedle) const;
+
+	int32 NumEntries() const { return Data.EntryCodepoints.Num(); }
+	int32 GetCodepoint(int32 const Entry) const { return Data.EntryCodepoints[Entry]; }
+
+	int32 NumTags() const { return Data.FoldedOffsets.Num() - 1; }
+	int32 NumTagEntries(int32 const TagId) const { return Data.GetTagEntries(TagId).Num(); }
+
+	FStringView GetFoldedTag(int32 const TagId) const
+	{
+		TConstArrayView<TCHAR> const Chars = FView::GetList(Data.FoldedOffsets, Data.FoldedChars, TagId);
+		return FStringView(Chars.GetData(), Chars.Num());
+	}
+
+	FView const& GetView() const { return Data; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	static FString Fold(FStringView Text);
+
+private:
+	static constexpr int32 GramLength = 3;
+
+	// packs a trigram into a single key, 21 bits per codepoint cover the full Unicode range
+	static uint64 PackTrigram(TCHAR const* Chars);
+
+	// copies the entries of the table and folds and indexes the tags which the previous index doesn't have
+	void Build(FUnicodeCharacterTagTable const& Table, FView const* Previous);
+
+	// one bit per tag id, set for the tags which contain the needle
+	void FindTags(FString const& FoldedNeedle, TBitArray<>& OutTagMask) const;
+
+	// the storage of an index which was built in memory, see FView
+	struct FStorage
+	{
+		TArray<TCHAR> FoldedChars;
+		TArray<int32> FoldedOffsets;
+		TArray<int32> EntryCodepoints;
+		TArray<int32> EntryTagOffsets;
+		TArray<int32> EntryTagIds;
+		TArray<int32> TagEntryOffsets;
+		TArray<int32> TagEntries;
+		TArray<uint64> PostingKeys;
+		TArray<int32> PostingOffsets;
+		TArray<int32> PostingTagIds;
+	};
+
+	FStorage Storage;
+	TSharedPtr<FUnicodeBrowserTagPack const> Pack; // keeps the mapped file alive which Data points into
+	FView Data;
+};
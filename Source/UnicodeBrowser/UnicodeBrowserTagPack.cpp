@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserTagPack.h"
+
+#include "Algo/AllOf.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+
+#include "Async/MappedFileHandle.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+#include "Misc/FileHelper.h"
+
+#include "UnicodeBrowser/DataAsset_FontTags.h"
+
+namespace UnicodeBrowser::TagPack
+{
+	uint32 constexpr Magic = 0x55425450; // UBTP
+
+	int32 constexpr PageBits = 8;
+	int32 constexpr NumPages = (0x10FFFF >> PageBits) + 1;
+
+	enum ESection : int32
+	{
+		TagChars,
+		TagOffsets,
+		FoldedChars,
+		FoldedOffsets,
+		EntryCodepoints,
+		EntryTagOffsets,
+		EntryTagIds,
+		TagEntryOffsets,
+		TagEntries,
+		PostingKeys,
+		PostingOffsets,
+		PostingTagIds,
+		PageOffsets,
+		PageEntries,
+
+		NumSections
+	};
+
+	// offset in bytes, size in elements
+	struct FSection
+	{
+		uint64 Offset = 0;
+		uint64 Num = 0;
+	};
+
+	struct FHeader
+	{
+		uint32 Magic = TagPack::Magic;
+		uint32 Version = FUnicodeBrowserTagPack::Version;
+		uint32 Key = 0;
+		uint32 CharSize = sizeof(TCHAR);
+		FSection Sections[NumSections];
+	};
+
+	// every section starts 8 byte aligned, so the mapped arrays can be read in place
+	template <typename T>
+	void AppendSection(TArray64<uint8>& Data, FHeader& Header, ESection const Section, TConstArrayView<T> const Values)
+	{
+		Data.AddZeroed(Align(Data.Num(), 8) - Data.Num());
+		Header.Sections[Section].Offset = Data.Num();
+		Header.Sections[Section].Num = Values.Num();
+		Data.Append(reinterpret_cast<uint8 const*>(Values.GetData()), Values.Num() * sizeof(T));
+	}
+
+	// the view of a section, false if it doesn't fit into the file
+	template <typename T>
+	bool GetSection(uint8 const* Data, uint64 const Size, FHeader const& Header, ESection const Section, TConstArrayView<T>& OutView)
+	{
+		FSection const& Entry = Header.Sections[Section];
+		if (Entry.Offset % alignof(T) != 0 || Entry.Num > MAX_int32 || Entry.Offset > Size || Entry.Num * sizeof(T) > Size - Entry.Offset)
+			return false;
+
+		OutView = TConstArrayView<T>(reinterpret_cast<T const*>(Data + Entry.Offset), static_cast<int32>(Entry.Num));
+		return true;
+	}
+
+	// offsets which are one longer than the list they split and end at its size
+	bool AreOffsetsValid(TConstArrayView<int32> const Offsets, int32 const NumLists, int32 const NumValues)
+	{
+		return Offsets.Num() == NumLists + 1 && Offsets[0] == 0 && Offsets.Last() == NumValues;
+	}
+}
+
+using namespace UnicodeBrowser::TagPack;
+
+bool FUnicodeBrowserTagPack::Write(FString const& Filename, FUnicodeCharacterTagTable const& Table, uint32 const Key)
+{
+	if (Table.Num() == 0)
+		return false;
+
+	FUnicodeBrowserTagIndex const Index(Table);
+	FUnicodeBrowserTagIndex::FView const& View = Index.GetView();
+
+	TArray<TCHAR> Chars;
+	TArray<int32> Offsets = {0};
+	Offsets.Reserve(Table.NumTags() + 1);
+	for (FString const& Tag : Table.Tags)
+	{
+		Chars.Append(*Tag, Tag.Len());
+		Offsets.Add(Chars.Num());
+	}
+
+	// the entries grouped by page, codepoints outside of the Unicode range can't be looked up
+	TArray<int32> Entries;
+	Entries.Reserve(Table.Num());
+	for (int32 Entry = 0; Entry < Table.Num(); ++Entry)
+	{
+		if (Table.Codepoints[Entry] >= 0 && Table.Codepoints[Entry] <= 0x10FFFF)
+		{
+			Entries.Add(Entry);
+		}
+	}
+
+	Entries.Sort([&Table](int32 const A, int32 const B) { return Table.Codepoints[A] != Table.Codepoints[B] ? Table.Codepoints[A] < Table.Codepoints[B] : A < B; });
+
+	TArray<int32> Pages;
+	Pages.SetNumZeroed(NumPages + 1);
+	for (int32 const Entry : Entries)
+	{
+		++Pages[(Table.Codepoints[Entry] >> PageBits) + 1];
+	}
+
+	for (int32 Page = 0; Page < NumPages; ++Page)
+	{
+		Pages[Page + 1] += Pages[Page];
+	}
+
+	FHeader Header;
+	Header.Key = Key;
+
+	TArray64<uint8> Data;
+	Data.AddZeroed(sizeof(FHeader));
+	AppendSection<TCHAR>(Data, Header, ESection::TagChars, Chars);
+	AppendSection<int32>(Data, Header, ESection::TagOffsets, Offsets);
+	AppendSection(Data, Header, ESection::FoldedChars, View.FoldedChars);
+	AppendSection(Data, Header, ESection::FoldedOffsets, View.FoldedOffsets);
+	AppendSection(Data, Header, ESection::EntryCodepoints, View.EntryCodepoints);
+	AppendSection(Data, Header, ESection::EntryTagOffsets, View.EntryTagOffsets);
+	AppendSection(Data, Header, ESection::EntryTagIds, View.EntryTagIds);
+	AppendSection(Data, Header, ESection::TagEntryOffsets, View.TagEntryOffsets);
+	AppendSection(Data, Header, ESection::TagEntries, View.TagEntries);
+	AppendSection(Data, Header, ESection::PostingKeys, View.PostingKeys);
+	AppendSection(Data, Header, ESection::PostingOffsets, View.PostingOffsets);
+	AppendSection(Data, Header, ESection::PostingTagIds, View.PostingTagIds);
+	AppendSection<int32>(Data, Header, ESection::PageOffsets, Pages);
+	AppendSection<int32>(Data, Header, ESection::PageEntries, Entries);
+	FMemory::Memcpy(Data.GetData(), &Header, sizeof(FHeader));
+
+	// write to a temporary file first, a preset which maps the previous pack never sees a partially written file
+	FString const TempFilename = FString::Printf(TEXT("%s.%s.tmp"), *Filename, *FGuid::NewGuid().ToString());
+	if (!FFileHelper::SaveArrayToFile(Data, *TempFilename))
+		return false;
+
+	if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilename, false, true, true);
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<FUnicodeBrowserTagPack const> FUnicodeBrowserTagPack::Open(FString const& Filename, uint32 const Key)
+{
+	TSharedRef<FUnicodeBrowserTagPack> Pack = MakeShareable(new FUnicodeBrowserTagPack());
+
+	Pack->MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!Pack->MappedFile.IsValid() || Pack->MappedFile->GetFileSize() < static_cast<int64>(sizeof(FHeader)))
+		return nullptr;
+
+	// no preload, the pages which no query touches are never read
+	Pack->MappedRegion.Reset(Pack->MappedFile->MapRegion(0, Pack->MappedFile->GetFileSize()));
+	if (!Pack->MappedRegion.IsValid())
+		return nullptr;
+
+	uint8 const* Data = Pack->MappedRegion->GetMappedPtr();
+	uint64 const Size = Pack->MappedRegion->GetMappedSize();
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(FHeader));
+	if (Header.Magic != Magic || Header.Version != Version || Header.Key != Key || Header.CharSize != sizeof(TCHAR))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[FUnicodeBrowserTagPack::Open] Ignoring outdated tag pack %s"), *Filename);
+		return nullptr;
+	}
+
+	FUnicodeBrowserTagIndex::FView& View = Pack->IndexView;
+	bool const bSectionsValid = GetSection(Data, Size, Header, ESection::TagChars, Pack->TagChars)
+		&& GetSection(Data, Size, Header, ESection::TagOffsets, Pack->TagOffsets)
+		&& GetSection(Data, Size, Header, ESection::FoldedChars, View.FoldedChars)
+		&& GetSection(Data, Size, Header, ESection::FoldedOffsets, View.FoldedOffsets)
+		&& GetSection(Data, Size, Header, ESection::EntryCodepoints, View.EntryCodepoints)
+		&& GetSection(Data, Size, Header, ESection::EntryTagOffsets, View.EntryTagOffsets)
+		&& GetSection(Data, Size, Header, ESection::EntryTagIds, View.EntryTagIds)
+		&& GetSection(Data, Size, Header, ESection::TagEntryOffsets, View.TagEntryOffsets)
+		&& GetSection(Data, Size, Header, ESection::TagEntries, View.TagEntries)
+		&& GetSection(Data, Size, Header, ESection::PostingKeys, View.PostingKeys)
+		&& GetSection(Data, Size, Header, ESection::PostingOffsets, View.PostingOffsets)
+		&& GetSection(Data, Size, Header, ESection::PostingTagIds, View.PostingTagIds)
+		&& GetSection(Data, Size, Header, ESection::PageOffsets, Pack->PageOffsets)
+		&& GetSection(Data, Size, Header, ESection::PageEntries, Pack->PageEntries);
+
+	int32 const NumTags = Pack->TagOffsets.Num() - 1;
+	bool const bValid = bSectionsValid
+		&& NumTags >= 0
+		&& AreOffsetsValid(Pack->TagOffsets, NumTags, Pack->TagChars.Num())
+		&& AreOffsetsValid(View.FoldedOffsets, NumTags, View.FoldedChars.Num())
+		&& AreOffsetsValid(View.EntryTagOffsets, View.EntryCodepoints.Num(), View.EntryTagIds.Num())
+		&& AreOffsetsValid(View.TagEntryOffsets, NumTags, View.TagEntries.Num())
+		&& AreOffsetsValid(View.PostingOffsets, View.PostingKeys.Num(), View.PostingTagIds.Num())
+		&& AreOffsetsValid(Pack->PageOffsets, NumPages, Pack->PageEntries.Num())
+		&& View.TagEntries.Num() == View.EntryTagIds.Num();
+
+	if (!bValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[FUnicodeBrowserTagPack::Open] Ignoring corrupted tag pack %s"), *Filename);
+		return nullptr;
+	}
+
+	return Pack;
+}
+
+FUnicodeBrowserTagPack::~FUnicodeBrowserTagPack() = default;
+
+FStringView FUnicodeBrowserTagPack::GetTag(int32 const TagId) const
+{
+	if (TagId < 0 || TagId >= NumTags())
+		return FStringView();
+
+	TConstArrayView<TCHAR> const Chars = FUnicodeBrowserTagIndex::FView::GetList(TagOffsets, TagChars, TagId);
+	return FStringView(Chars.GetData(), Chars.Num());
+}
+
+int32 FUnicodeBrowserTagPack::FindEntry(int32 const Codepoint) const
+{
+	if (Codepoint < 0 || Codepoint > 0x10FFFF)
+		return INDEX_NONE;
+
+	int32 const Page = Codepoint >> PageBits;
+	TConstArrayView<int32> const Entries = FUnicodeBrowserTagIndex::FView::GetList(PageOffsets, PageEntries, Page);
+	auto const GetCodepoint = [this](int32 const Entry) { return IndexView.IsValidEntry(Entry) ? IndexView.EntryCodepoints[Entry] : INDEX_NONE; };
+	int32 const Found = Algo::LowerBoundBy(Entries, Codepoint, GetCodepoint);
+
+	return Found < Entries.Num() && GetCodepoint(Entries[Found]) == Codepoint ? Entries[Found] : INDEX_NONE;
+}
+
+bool FUnicodeBrowserTagPack::ToTable(FUnicodeCharacterTagTable& OutTable) const
+{
+	// the table trusts its arrays, so unlike a query the copy checks every list and id once
+	// the first and last offsets were validated on open, sorted offsets keep every list in range
+	if (!Algo::IsSorted(TagOffsets) || !Algo::IsSorted(IndexView.EntryTagOffsets)
+		|| !Algo::AllOf(IndexView.EntryTagIds, [this](int32 const TagId) { return IndexView.IsValidTag(TagId); }))
+	{
+		return false;
+	}
+
+	// the arrays are copied as they are, the tag lookup of the table gets rebuilt on demand like after loading
+	OutTable = FUnicodeCharacterTagTable();
+	OutTable.Tags.Reserve(NumTags());
+	for (int32 TagId = 0; TagId < NumTags(); ++TagId)
+	{
+		OutTable.Tags.Emplace(GetTag(TagId));
+	}
+
+	OutTable.Codepoints.Append(IndexView.EntryCodepoints.GetData(), IndexView.EntryCodepoints.Num());
+	OutTable.TagOffsets.Append(IndexView.EntryTagOffsets.GetData(), IndexView.EntryTagOffsets.Num());
+	OutTable.TagIds.Append(IndexView.EntryTagIds.GetData(), IndexView.EntryTagIds.Num());
+	return true;
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FUnicodeCharacterTagTable;
+
+/**
+ * binary file with the tags of a font tags preset which opts in (see UDataAsset_FontTags::bUseTagPack), built from the tags in its package
+ * it contains the tag strings, the prebuilt search index and a page table (256 codepoints per page) over the codepoints,
+ * all as flat arrays behind a header with the offset of every section
+ * the file is memory mapped and queried in place, opening a pack only reads its header and nothing gets copied, only the pages a query touches get loaded
+ * the layout is native-endian, packs are a local editor cache of the tags which can be deleted at any time and aren't meant to be moved between platforms
+ */
+class UNICODEBROWSER_API FUnicodeBrowserTagPack
+{
+public:
+	// bump this whenever the layout of the file or the search index changes
+	static constexpr uint32 Version = 3;
+
+	// writes the tags of the table together with their search index, the key identifies the content (the hash of the table)
+	// returns false if the table is empty or the file can't be written
+	static bool Write(FString const& Filename, FUnicodeCharacterTagTable const& Table, uint32 Key);
+
+	// maps the file, returns null if it doesn't exist, is outdated, was written for a different key or is damaged
+	// only the header and the sizes of the sections are validated, the lists and ids within the sections are bounds checked where they are read
+	static TSharedPtr<FUnicodeBrowserTagPack const> Open(FString const& Filename, uint32 Key);
+
+	~FUnicodeBrowserTagPack();
+
+	UE_NONCOPYABLE(FUnicodeBrowserTagPack);
+
+	// the search index which was stored with the tags, it points into the mapped file
+	FUnicodeBrowserTagIndex::FView const& GetIndexView() const { return IndexView; }
+
+	int32 NumEntries() const { return IndexView.EntryCodepoints.Num(); }
+	int32 NumTags() const { return TagOffsets.Num() - 1; }
+
+	// the tag with its original case, empty if the tag id is out of range
+	FStringView GetTag(int32 const TagId) const;
+
+	// the entry of the codepoint (the character index in the table which was written), INDEX_NONE if the pack has no tags for it
+	int32 FindEntry(int32 Codepoint) const;
+
+	// the table which was written, with the same tag ids
+	// this reads the whole pack, false if any of its lists or ids is out of range
+	bool ToTable(FUnicodeCharacterTagTable& OutTable) const;
+
+private:
+	FUnicodeBrowserTagPack() = default;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion; // declared after the handle, so it gets unmapped first
+
+	FUnicodeBrowserTagIndex::FView IndexView;
+	TConstArrayView<TCHAR> TagChars;
+	TConstArrayView<int32> TagOffsets; // tag id t is TagChars[TagOffsets[t]] to TagChars[TagOffsets[t + 1] - 1]
+	TConstArrayView<int32> PageOffsets; // the entries of page p are PageEntries[PageOffsets[p]] to PageEntries[PageOffsets[p + 1] - 1]
+	TConstArrayView<int32> PageEntries; // sorted by codepoint within a page
+};
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#include "UnicodeBrowser/UnicodeBrowserTagTrie.h"
+
+#include "Algo/BinarySearch.h"
+
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+
+FUnicodeBrowserTagTrie::FUnicodeBrowserTagTrie(FUnicodeBrowserTagIndex const& Index)
+{
+	// the tags of a character are distinct, so the entries of a tag id are its glyphs, tags which only differ by case share a node
+	TMap<FString, int32> GlyphCounts;
+	for (int32 TagId = 0; TagId < Index.NumTags(); ++TagId)
+	{
+		FString FoldedTag(Index.GetFoldedTag(TagId).TrimStartAndEnd());
+		if (!FoldedTag.IsEmpty() && Index.NumTagEntries(TagId) > 0)
+		{
+			GlyphCounts.FindOrAdd(MoveTemp(FoldedTag)) += Index.NumTagEntries(TagId);
+		}
+	}
+
+	GlyphCounts.KeySort([](FString const& A, FString const& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+	Tags.Reserve(GlyphCounts.Num());
+	TagGlyphs.Reserve(GlyphCounts.Num());
+	for (auto& [Tag, NumGlyphs] : GlyphCounts)
+	{
+		Tags.Add(MoveTemp(Tag));
+		TagGlyphs.Add(NumGlyphs);
+	}
+
+	// the rank orders tags by their glyphs, ties alphabetically, so completions only need to compare a single number
+	TArray<int32> Ranks;
+	{
+		TArray<int32> Order;
+		Order.Reserve(Tags.Num());
+		for (int32 Tag = 0; Tag < Tags.Num(); ++Tag)
+		{
+			Order.Add(Tag);
+		}
+
+		Order.Sort([this](int32 const A, int32 const B) { return TagGlyphs[A] != TagGlyphs[B] ? TagGlyphs[A] > TagGlyphs[B] : A < B; });
+
+		Ranks.SetNumUninitialized(Tags.Num());
+		for (int32 Rank = 0; Rank < Order.Num(); ++Rank)
+		{
+			Ranks[Order[Rank]] = Rank;
+		}
+	}
+
+	// every node covers the contiguous slice of the sorted tags which start with its prefix, the slices are split breadth first
+	struct FPendingNode
+	{
+		int32 Node;
+		int32 Depth;
+		int32 FirstTag;
+		int32 EndTag;
+	};
+
+	TArray<int32> NodeTags; // the tag which ends at the node, INDEX_NONE if none does
+	TArray<FPendingNode> Pending;
+	Pending.Add({0, 0, 0, Tags.Num()});
+	Nodes.AddDefaulted();
+	NodeCharacters.Add(TEXT('\0'));
+	NodeTags.Add(INDEX_NONE);
+
+	for (int32 PendingIndex = 0; PendingIndex < Pending.Num(); ++PendingIndex)
+	{
+		FPendingNode const Current = Pending[PendingIndex];
+
+		// a tag which ends here sorts before all tags which continue
+		int32 Tag = Current.FirstTag;
+		if (Tag < Current.EndTag && Tags[Tag].Len() == Current.Depth)
+		{
+			NodeTags[Current.Node] = Tag++;
+		}
+
+		Nodes[Current.Node].FirstChild = Nodes.Num();
+		while (Tag < Current.EndTag)
+		{
+			TCHAR const Character = Tags[Tag][Current.Depth];
+			int32 const FirstTag = Tag;
+			while (Tag < Current.EndTag && Tags[Tag][Current.Depth] == Character)
+			{
+				++Tag;
+			}
+
+			Pending.Add({Nodes.Num(), Current.Depth + 1, FirstTag, Tag});
+			Nodes.AddDefaulted();
+			NodeCharacters.Add(Character);
+			NodeTags.Add(INDEX_NONE);
+			++Nodes[Current.Node].NumChildren;
+		}
+	}
+
+	// children come after their parent, so walking backwards merges the completions of a subtree bottom up
+	TArray<TArray<int32, TInlineAllocator<MaxCompletions>>> NodeCompletions;
+	NodeCompletions.SetNum(Nodes.Num());
+	TArray<int32, TInlineAllocator<64>> Candidates;
+	for (int32 Node = Nodes.Num() - 1; Node >= 0; --Node)
+	{
+		Candidates.Reset();
+		if (NodeTags[Node] != INDEX_NONE)
+		{
+			Candidates.Add(NodeTags[Node]);
+		}
+
+		for (int32 Child = Nodes[Node].FirstChild; Child < Nodes[Node].FirstChild + Nodes[Node].NumChildren; ++Child)
+		{
+			Candidates.Append(NodeCompletions[Child]);
+		}
+
+		Candidates.Sort([&Ranks](int32 const A, int32 const B) { return Ranks[A] < Ranks[B]; });
+		NodeCompletions[Node].Append(Candidates.GetData(), FMath::Min(Candidates.Num(), MaxCompletions));
+	}
+
+	for (int32 Node = 0; Node < Nodes.Num(); ++Node)
+	{
+		Nodes[Node].FirstCompletion = Completions.Num();
+		Nodes[Node].NumCompletions = NodeCompletions[Node].Num();
+		Completions.Append(NodeCompletions[Node]);
+	}
+
+	Tags.Shrink();
+	Nodes.Shrink();
+	NodeCharacters.Shrink();
+	Completions.Shrink();
+}
+
+void FUnicodeBrowserTagTrie::FindCompletions(FStringView const Prefix, TArray<FCompletion>& OutCompletions) const
+{
+	FString const FoldedPrefix = FUnicodeBrowserTagIndex::Fold(Prefix);
+	if (FoldedPrefix.IsEmpty())
+		return;
+
+	int32 Node = 0;
+	for (TCHAR const Character : FoldedPrefix)
+	{
+		Node = FindChild(Node, Character);
+		if (Node == INDEX_NONE)
+			return;
+	}
+
+	for (int32 const Tag : MakeArrayView(Completions).Mid(Nodes[Node].FirstCompletion, Nodes[Node].NumCompletions))
+	{
+		// the prefix is a complete tag already
+		if (Tags[Tag].Len() == FoldedPrefix.Len())
+			continue;
+
+		OutCompletions.Add({Tags[Tag], TagGlyphs[Tag]});
+	}
+}
+
+SIZE_T FUnicodeBrowserTagTrie::GetAllocatedSize() const
+{
+	SIZE_T Size = Tags.GetAllocatedSize() + TagGlyphs.GetAllocatedSize() + Nodes.GetAllocatedSize() + NodeCharacters.GetAllocatedSize() + Completions.GetAllocatedSize();
+	for (FString const& Tag : Tags)
+	{
+		Size += Tag.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+int32 FUnicodeBrowserTagTrie::FindChild(int32 const Node, TCHAR const Character) const
+{
+	TConstArrayView<TCHAR> const Children = MakeArrayView(NodeCharacters).Mid(Nodes[Node].FirstChild, Nodes[Node].NumChildren);
+	int32 const Child = Algo::BinarySearch(Children, Character);
+	return Child == INDEX_NONE ? INDEX_NONE : Nodes[Node].FirstChild + Child;
+}
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 NTY.studio
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FUnicodeBrowserTagIndex;
+
+/**
+ * prefix trie over the distinct, case folded tags of a font tags preset, used to complete what the user is typing
+ * every node keeps the best completions of its subtree (most glyphs first), so a lookup only walks the prefix
+ * and never visits the subtree, no matter how many tags share the prefix
+ * the trie is immutable once built, so lookups may run on any thread
+ */
+class UNICODEBROWSER_API FUnicodeBrowserTagTrie
+{
+public:
+	static constexpr int32 MaxCompletions = 8;
+
+	struct FCompletion
+	{
+		FString Tag;
+		int32 NumGlyphs = 0; // amount of entries with this tag
+	};
+
+	// built from the folded tags of the index, which a tag pack stores already
+	explicit FUnicodeBrowserTagTrie(FUnicodeBrowserTagIndex const& Index);
+
+	// appends up to MaxCompletions tags starting with the prefix (case-insensitive), most glyphs first, the prefix itself is left out
+	void FindCompletions(FStringView Prefix, TArray<FCompletion>& OutCompletions) const;
+
+	int32 NumTags() const { return Tags.Num(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FNode
+	{
+		int32 FirstChild = 0; // children are stored next to each other, sorted by their character
+		int32 NumChildren = 0;
+		int32 FirstCompletion = 0; // into Completions
+		int32 NumCompletions = 0;
+	};
+
+	// index of the child of the node with the character, INDEX_NONE if there is none
+	int32 FindChild(int32 Node, TCHAR Character) const;
+
+	TArray<FString> Tags; // sorted ordinally
+	TArray<int32> TagGlyphs; // parallel to Tags
+
+	TArray<FNode> Nodes; // breadth first, the root is the first node
+	TArray<TCHAR> NodeCharacters; // parallel to Nodes, the character of the edge from the parent
+	TArray<int32> Completions; // the best tag indices of every node
+};
@@ -7,6 +7,10 @@
 #include "ToolMenus.h"
 #include "UnicodeBrowserOptions.h"
 
+#include "Algo/BinarySearch.h"
+
+#include "Async/Async.h"
+
 #include "Fonts/UnicodeBlockRange.h"
 
 #include "Framework/Application/SlateApplication.h"
@@ -14,7 +18,13 @@
 #include "Modules/ModuleManager.h"
 
 #include "UnicodeBrowser/DataAsset_FontTags.h"
+#include "UnicodeBrowser/UnicodeBrowserCodepointTable.h"
+#include "UnicodeBrowser/UnicodeBrowserFontDataSubsystem.h"
+#include "UnicodeBrowser/UnicodeBrowserNameIndex.h"
+#include "UnicodeBrowser/UnicodeBrowserQuery.h"
 #include "UnicodeBrowser/UnicodeBrowserStatic.h"
+#include "UnicodeBrowser/UnicodeBrowserTagIndex.h"
+#include "UnicodeBrowser/UnicodeBrowserTagTrie.h"
 
 #include "Widgets/SUnicodeBrowserSidePanel.h"
 #include "Widgets/SUnicodeCharacterGridEntry.h"
@@ -22,12 +32,37 @@
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SComboButton.h"
 #include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/Layout/SGridPanel.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SSpacer.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Views/STileView.h"
 
+namespace UnicodeBrowser::BrowserWidget
+{
+	int32 GetBestMatchesCount()
+	{
+		UUnicodeBrowserOptions const* Options = UUnicodeBrowserOptions::Get();
+		return Options->bSearch_BestMatches ? FMath::Max(Options->Search_BestMatchesCount, 0) : 0;
+	}
+
+	// ranks the scored codepoints among the matches of the query mask, Count = 0 skips the ranking
+	void SelectBestMatches(FUnicodeBrowserCodepointTable const& Table, TBitArray<> const& Mask, FUnicodeBrowserQuery::FScores const& Scores, int32 const Count, TArray<int32>& OutCodepoints)
+	{
+		FUnicodeBrowserQuery::SelectBestMatches(
+			Scores,
+			Count,
+			[&Table, &Mask](int32 const Codepoint)
+			{
+				int32 const Index = Table.FindIndex(Codepoint);
+				return Index != INDEX_NONE && Mask[Index];
+			},
+			OutCodepoints
+		);
+	}
+}
+
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 SUnicodeBrowserWidget::~SUnicodeBrowserWidget()
@@ -36,6 +71,20 @@ SUnicodeBrowserWidget::~SUnicodeBrowserWidget()
 	UToolMenus::Get()->RemoveMenu("UnicodeBrowser.Font");
 	UUnicodeBrowserOptions::Get()->OnFontChanged.RemoveAll(this);
 	CleanUpDisableCPUThrottlingDelegate();
+
+	if (UUnicodeBrowserFontDataSubsystem* FontDataSubsystem = UUnicodeBrowserFontDataSubsystem::Get())
+	{
+		FontDataSubsystem->OnFontDataInvalidated.RemoveAll(this);
+		FontDataSubsystem->CancelRequests(this);
+
+		// the table stays retained by the subsystem, it's only released if the memory budget is exceeded
+		if (CodepointTable.IsValid())
+		{
+			CodepointTable->SaveCachedMetrics();
+		}
+
+		FontDataSubsystem->RequestTrim();
+	}
 }
 
 FReply SUnicodeBrowserWidget::OnMouseMove(FGeometry const& MyGeometry, FPointerEvent const& MouseEvent)
@@ -49,6 +98,9 @@ void SUnicodeBrowserWidget::Construct(FArguments const& InArgs)
 	SetUpDisableCPUThrottlingDelegate();
 	CurrentFont = UUnicodeBrowserOptions::Get()->GetFontInfo();
 
+	// the name index takes a moment to build, have it ready before the first search or hover
+	Async(EAsyncExecution::ThreadPool, [] { FUnicodeBrowserNameIndex::Get(); });
+
 	UUnicodeBrowserOptions::Get()->OnFontChanged.RemoveAll(this);
 	UUnicodeBrowserOptions::Get()->OnFontChanged.AddLambda(
 		[this, UnicodeBrowser = AsWeak()]()
@@ -68,11 +120,18 @@ void SUnicodeBrowserWidget::Construct(FArguments const& InArgs)
 		}
 	);
 
+	// the shared font data got dropped (e.g. the font asset was edited), request a fresh table
+	if (UUnicodeBrowserFontDataSubsystem* FontDataSubsystem = UUnicodeBrowserFontDataSubsystem::Get())
+	{
+		FontDataSubsystem->OnFontDataInvalidated.AddSPLambda(this, [this]() { MarkDirty(static_cast<uint8>(EDirtyFlags::FONT)); });
+	}
+
 	// create a dummy for the preview until the user highlights a character
-	CurrentRow = MakeShared<FUnicodeBrowserRow>(UnicodeBrowser::InvalidSubChar, EUnicodeBlockRange::Specials, &CurrentFont);
+	CurrentRow = FUnicodeBrowserCodepointTable::CreateSingle(CurrentFont, UnicodeBrowser::InvalidSubChar, EUnicodeBlockRange::Specials)->GetRow(0);
 
 	SearchBar = SNew(SUbSearchBar)
-		.OnTextChanged(this, &SUnicodeBrowserWidget::FilterByString);
+		.OnTextChanged(this, &SUnicodeBrowserWidget::FilterByString)
+		.OnGetCompletions(this, &SUnicodeBrowserWidget::GetSearchCompletions);
 
 	// generate the settings context menu
 	UToolMenu* Menu = UToolMenus::Get()->RegisterMenu("UnicodeBrowser.Settings");
@@ -220,6 +279,19 @@ void SUnicodeBrowserWidget::Construct(FArguments const& InArgs)
 				]
 				+ SHorizontalBox::Slot()
 				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SBox)
+					.WidthOverride(100)
+					.Visibility_Lambda([this]() { return bIsRequestingTable || bIsPopulating ? EVisibility::Visible : EVisibility::Collapsed; })
+					.ToolTipText(INVTEXT("loading the characters of the font"))
+					[
+						SNew(SProgressBar)
+						.Percent(this, &SUnicodeBrowserWidget::GetPopulateProgress)
+					]
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
 				[
 					SNew(SSpacer)
 					.Size(FVector2D(10, 1))
@@ -253,12 +325,48 @@ void SUnicodeBrowserWidget::Construct(FArguments const& InArgs)
 			.SizeRule(SSplitter::FractionOfParent)
 			.Value(0.7)
 			[
-				SAssignNew(CharactersTileView, STileView<TSharedPtr<FUnicodeBrowserRow>>)
-				.ListItemsSource(&CharacterWidgetsArray)
-				.ItemAlignment(EListItemAlignment::EvenlySize)
-				.SelectionMode(ESelectionMode::None)
-				.OnGenerateTile(this, &SUnicodeBrowserWidget::GenerateItemRow)
-				.OnTileViewScrolled(this, &SUnicodeBrowserWidget::OnCharactersTileViewScrolled)
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(4, 2)
+				[
+					// sticky header with the block of the topmost visible row
+					SNew(STextBlock)
+					.Font(FAppStyle::Get().GetFontStyle("DetailsView.CategoryFontStyle"))
+					.TextStyle(FAppStyle::Get(), "DetailsView.CategoryTextStyle")
+					.Text(this, &SUnicodeBrowserWidget::GetCurrentBlockText)
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(4, 2)
+				[
+					SNew(SHorizontalBox)
+					.Visibility(this, &SUnicodeBrowserWidget::GetBestMatchesVisibility)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					.Padding(0, 0, 8, 0)
+					[
+						SNew(STextBlock)
+						.Text(INVTEXT("Best Matches"))
+					]
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					[
+						SAssignNew(BestMatchesBox, SScrollBox)
+						.Orientation(Orient_Horizontal)
+					]
+				]
+				+ SVerticalBox::Slot()
+				.FillHeight(1.0f)
+				[
+					SAssignNew(CharactersTileView, STileView<TSharedPtr<FUnicodeBrowserRow>>)
+					.ListItemsSource(&CharacterWidgetsArray)
+					.ItemAlignment(EListItemAlignment::EvenlySize)
+					.SelectionMode(ESelectionMode::None)
+					.OnGenerateTile(this, &SUnicodeBrowserWidget::GenerateItemRow)
+					.OnTileViewScrolled(this, &SUnicodeBrowserWidget::OnCharactersTileViewScrolled)
+				]
 			]
 			+ SSplitter::Slot()
 			.SizeRule(SSplitter::FractionOfParent)
@@ -307,6 +415,7 @@ UToolMenu* SUnicodeBrowserWidget::CreateMenuSection_Settings()
 						UUnicodeBrowserOptions::Get()->bShowMissing = !UUnicodeBrowserOptions::Get()->bShowMissing;
 						UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
 						UpdateCharacters();
+						CharactersTileView->RequestListRefresh();
 					}
 				),
 				FCanExecuteAction(),
@@ -331,6 +440,7 @@ UToolMenu* SUnicodeBrowserWidget::CreateMenuSection_Settings()
 						UUnicodeBrowserOptions::Get()->bShowZeroSize = !UUnicodeBrowserOptions::Get()->bShowZeroSize;
 						UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
 						UpdateCharacters();
+						CharactersTileView->RequestListRefresh();
 					}
 				),
 				FCanExecuteAction(),
@@ -379,7 +489,7 @@ UToolMenu* SUnicodeBrowserWidget::CreateMenuSection_Settings()
 						UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
 						if (UUnicodeBrowserOptions::Get()->bAutoSetRangeOnFontChange)
 						{
-							SidePanel->SelectAllRangesWithCharacters(RowsRaw);
+							SidePanel->SelectAllRangesWithCharacters(CodepointTable);
 						}
 					}
 				),
@@ -522,20 +632,21 @@ void SUnicodeBrowserWidget::Tick(FGeometry const& AllottedGeometry, double const
 					}
 				}
 
+				// the range auto selection and OnFontChanged happen once the new table arrives
 				PopulateSupportedCharacters();
-				if (UUnicodeBrowserOptions::Get()->bAutoSetRangeOnFontChange)
-				{
-					SidePanel->SelectAllRangesWithCharacters(RowsRaw);
-				}
-
-				OnFontChanged.Broadcast(&CurrentFont);
 
 				DirtyFlags &= ~static_cast<uint8>(EDirtyFlags::FONT_FACE);
 			}
 
 			if (DirtyFlags & static_cast<uint8>(EDirtyFlags::FONT_STYLE))
 			{
+				if (CodepointTable.IsValid())
+				{
+					CodepointTable->SetFontInfo(CurrentFont);
+				}
+
 				CharactersTileView->RebuildList();
+				RebuildBestMatches();
 				MarkDirty(static_cast<uint8>(EDirtyFlags::TILEVIEW_GRID_SIZE)); // set grid size dirty
 				DirtyFlags &= ~static_cast<uint8>(EDirtyFlags::FONT_STYLE);
 			}
@@ -557,70 +668,419 @@ void SUnicodeBrowserWidget::Tick(FGeometry const& AllottedGeometry, double const
 		}
 	}
 
-	SetCanTick(DirtyFlags != 0);
+	if (bIsPopulating && CodepointTable.IsValid())
+	{
+		// publish as many blocks as possible within a few milliseconds, the rest follows on the next ticks
+		PublishBlocks(0.008);
+	}
+
+	SetCanTick(DirtyFlags != 0 || bIsPopulating);
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 }
 
 void SUnicodeBrowserWidget::PopulateSupportedCharacters()
 {
-	RowsRaw.Empty();
-	RowsRaw.Reserve(UnicodeBrowser::GetUnicodeBlockRanges().Num());
+	// any request which is still in flight is stale from now on
+	// the current table stops streaming, publishing only starts again once the new table replaced it (see OnCodepointTablePopulated)
+	int32 const Generation = ++PopulateGeneration;
+	bIsPopulating = false;
+	bIsRequestingTable = false;
+
+	UUnicodeBrowserFontDataSubsystem* FontDataSubsystem = UUnicodeBrowserFontDataSubsystem::Get();
+	if (!FontDataSubsystem)
+		return;
+
+	// a run which only this browser waits for doesn't need to finish
+	FontDataSubsystem->CancelRequests(this);
 
-	for (auto const& Range : UnicodeBrowser::GetUnicodeBlockRanges())
+	// tables which are retained by the subsystem (e.g. when the tab gets reopened) are shown within the same frame
+	if (TSharedPtr<FUnicodeBrowserCodepointTable> const Table = FontDataSubsystem->FindTable(CurrentFont))
 	{
-		RowsRaw.Add(Range.Index);
-		TArray<TSharedPtr<FUnicodeBrowserRow>>& RangeArray = RowsRaw.FindChecked(Range.Index);
+		OnCodepointTablePopulated(Table.ToSharedRef(), false);
+		return;
+	}
 
-		for (int CharCode = Range.GetRange().GetLowerBound().GetValue(); CharCode <= Range.GetRange().GetUpperBound().GetValue(); ++CharCode)
-		{
-			auto Row = MakeShared<FUnicodeBrowserRow>(CharCode, Range.Index, &CurrentFont);
+	bIsRequestingTable = true;
+	FontDataSubsystem->RequestTable(
+		CurrentFont,
+		UUnicodeBrowserFontDataSubsystem::FOnTableReady::CreateSPLambda(
+			this,
+			[this, Generation](TSharedRef<FUnicodeBrowserCodepointTable> const& Table)
+			{
+				// drop the result if the font changed again in the meantime
+				if (PopulateGeneration == Generation)
+				{
+					OnCodepointTablePopulated(Table, true);
+				}
+			}
+		)
+	);
+}
+
+void SUnicodeBrowserWidget::OnCodepointTablePopulated(TSharedRef<FUnicodeBrowserCodepointTable> const& Table, bool const bStream)
+{
+	if (CodepointTable.IsValid() && CodepointTable != Table)
+	{
+		CodepointTable->SaveCachedMetrics();
+	}
+
+	// a search which is still running was started for the previous table, its mask doesn't fit this one
+	SearchGeneration->Increment();
+
+	CodepointTable = Table;
+	CodepointTable->SetFontInfo(CurrentFont);
+	NumPublishedBlocks = 0;
+	bIsRequestingTable = false;
+	bIsPopulating = true;
+
+	RangeFilter.Init(false, CodepointTable->Num());
+	SearchFilter.Init(true, CodepointTable->Num());
+	VisibleMask.Init(false, CodepointTable->Num());
+
+	Rows.Reset();
+	CharacterWidgetsArray.Reset();
+	UpdateBlockListOffsets();
+	CharactersTileView->RebuildList();
+
+	BestMatchRows.Reset();
+	RebuildBestMatches();
+
+	if (UUnicodeBrowserOptions::Get()->bAutoSetRangeOnFontChange)
+	{
+		SidePanel->SelectAllRangesWithCharacters(CodepointTable);
+	}
+
+	// reapply the current search to the new table
+	if (SearchBar.IsValid() && !SearchBar->GetText().IsEmpty())
+	{
+		FilterByString(SearchBar->GetText().ToString());
+	}
 
-			if (UUnicodeBrowserOptions::Get()->bCacheCharacterMetaOnLoad)
+	UpdateRangeFilter();
+	UpdateVisibleMask();
+
+	if (bStream)
+	{
+		SetCanTick(true);
+	}
+	else
+	{
+		// a retained table already went through the expensive part, publish everything right away
+		PublishBlocks(TNumericLimits<double>::Max());
+	}
+}
+
+void SUnicodeBrowserWidget::PublishBlocks(double const TimeBudget)
+{
+	double const StartTime = FPlatformTime::Seconds();
+	bool const bPreload = UUnicodeBrowserOptions::Get()->bCacheCharacterMetaOnLoad;
+	TConstArrayView<FUnicodeBrowserCodepointTable::FBlock> const Blocks = CodepointTable->GetBlocks();
+
+	bool bPublishedAny = false;
+	while (NumPublishedBlocks < Blocks.Num() && FPlatformTime::Seconds() - StartTime < TimeBudget)
+	{
+		FUnicodeBrowserCodepointTable::FBlock const& Block = Blocks[NumPublishedBlocks];
+
+		// measuring requires the Slate font cache, so this part stays on the game thread
+		if (bPreload)
+		{
+			for (int32 Index = Block.Offset; Index < Block.Offset + Block.Num; ++Index)
 			{
-				Row->Preload();
+				CodepointTable->Preload(Index);
 			}
+		}
 
-			RangeArray.Add(Row);
+		TArray<TSharedPtr<FUnicodeBrowserRow>> RowsFiltered;
+		FilterBlock(NumPublishedBlocks, RowsFiltered);
+		if (!RowsFiltered.IsEmpty())
+		{
+			// blocks are published in table order, so appending keeps the same order as UpdateCharactersArray
+			CharacterWidgetsArray.Append(RowsFiltered);
+			Rows.Add(Block.Range, MoveTemp(RowsFiltered));
+			bPublishedAny = true;
 		}
+
+		++NumPublishedBlocks;
+	}
+
+	if (bPublishedAny)
+	{
+		UpdateBlockListOffsets();
+		CharactersTileView->RequestListRefresh();
 	}
 
-	UpdateCharacters();
+	if (NumPublishedBlocks >= Blocks.Num())
+	{
+		bIsPopulating = false;
+		OnFontChanged.Broadcast(&CurrentFont);
+		MarkDirty(static_cast<uint8>(EDirtyFlags::TILEVIEW_GRID_SIZE));
+	}
+}
+
+TOptional<float> SUnicodeBrowserWidget::GetPopulateProgress() const
+{
+	// marquee while the background task is running
+	if (bIsRequestingTable || !bIsPopulating || !CodepointTable.IsValid() || CodepointTable->GetBlocks().IsEmpty())
+		return {};
+
+	return static_cast<float>(NumPublishedBlocks) / CodepointTable->GetBlocks().Num();
 }
 
 void SUnicodeBrowserWidget::UpdateCharacters()
 {
-	Rows.Empty(RowsRaw.Num());
+	Rows.Empty(CodepointTable.IsValid() ? CodepointTable->GetBlocks().Num() : 0);
 
-	for (auto const& [Range, RawRangeRows] : RowsRaw)
+	if (CodepointTable.IsValid())
 	{
-		// we can skip the whole range if it's not selected
-		if (!SidePanel->RangeSelector->IsRangeChecked(Range))
-			continue;
+		UpdateRangeFilter();
+		UpdateVisibleMask();
 
-		TArray<TSharedPtr<FUnicodeBrowserRow>> RowsFiltered;
-		RowsFiltered = RawRangeRows.FilterByPredicate(
-			[](TSharedPtr<FUnicodeBrowserRow> const& RawRow)
+		// while populating only the already published blocks are visible
+		int32 const NumBlocks = bIsPopulating ? NumPublishedBlocks : CodepointTable->GetBlocks().Num();
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			TArray<TSharedPtr<FUnicodeBrowserRow>> RowsFiltered;
+			FilterBlock(BlockIndex, RowsFiltered);
+
+			if (!RowsFiltered.IsEmpty())
 			{
-				if (RawRow->bFilteredByTag)
-					return false;
+				Rows.Add(CodepointTable->GetBlocks()[BlockIndex].Range, MoveTemp(RowsFiltered));
+			}
+		}
+	}
 
-				if (!UUnicodeBrowserOptions::Get()->bShowMissing && !RawRow->CanLoadCodepoint())
-					return false;
+	UpdateCharactersArray();
+	UpdateBlockListOffsets();
+}
+
+void SUnicodeBrowserWidget::UpdateRangeFilter()
+{
+	RangeFilter.Init(false, CodepointTable->Num());
+
+	for (FUnicodeBrowserCodepointTable::FBlock const& Block : CodepointTable->GetBlocks())
+	{
+		if (SidePanel->RangeSelector->IsRangeChecked(Block.Range))
+		{
+			RangeFilter.SetRange(Block.Offset, Block.Num, true);
+		}
+	}
+}
+
+void SUnicodeBrowserWidget::UpdateVisibleMask()
+{
+	// word wise ANDs, toggling an option doesn't touch any row
+	VisibleMask = RangeFilter;
+	VisibleMask.CombineWithBitwiseAND(SearchFilter, EBitwiseOperatorFlags::MaintainSize);
+
+	if (!UUnicodeBrowserOptions::Get()->bShowMissing)
+	{
+		VisibleMask.CombineWithBitwiseAND(CodepointTable->GetCoveredMask(), EBitwiseOperatorFlags::MaintainSize);
+	}
+}
+
+void SUnicodeBrowserWidget::UpdateVisibleMask(int32 const StartIndex, int32 const Count)
+{
+	bool const bShowMissing = UUnicodeBrowserOptions::Get()->bShowMissing;
+	TBitArray<> const& CoveredMask = CodepointTable->GetCoveredMask();
+
+	for (int32 Index = StartIndex; Index < StartIndex + Count; ++Index)
+	{
+		VisibleMask[Index] = RangeFilter[Index] && SearchFilter[Index] && (bShowMissing || CoveredMask[Index]);
+	}
+}
+
+void SUnicodeBrowserWidget::OnRangeToggled(EUnicodeBlockRange const Range)
+{
+	PendingRangeToggles.Add(Range);
+}
 
-				if (!UUnicodeBrowserOptions::Get()->bShowZeroSize && RawRow->GetMeasurements().IsZero())
-					return false;
+void SUnicodeBrowserWidget::ApplyRangeSelection()
+{
+	// presets toggle lots of ranges at once, rebuilding everything is cheaper then
+	constexpr int32 MaxSplicedBlocks = 8;
 
-				return true;
+	if (CodepointTable.IsValid())
+	{
+		if (PendingRangeToggles.Num() > MaxSplicedBlocks)
+		{
+			UpdateCharacters();
+			CharactersTileView->RequestListRefresh();
+		}
+		else
+		{
+			bool bChanged = false;
+			for (EUnicodeBlockRange const Range : PendingRangeToggles)
+			{
+				int32 const BlockIndex = CodepointTable->FindBlockIndex(Range);
+				if (BlockIndex != INDEX_NONE)
+				{
+					bChanged |= SpliceBlock(BlockIndex);
+				}
 			}
-		);
 
-		if (!RowsFiltered.IsEmpty())
+			// the tile view keeps the widgets of all rows which are still listed
+			if (bChanged)
+			{
+				CharactersTileView->RequestListRefresh();
+			}
+		}
+	}
+
+	PendingRangeToggles.Reset();
+}
+
+bool SUnicodeBrowserWidget::SpliceBlock(int32 const BlockIndex)
+{
+	TConstArrayView<FUnicodeBrowserCodepointTable::FBlock> const Blocks = CodepointTable->GetBlocks();
+	FUnicodeBrowserCodepointTable::FBlock const& Block = Blocks[BlockIndex];
+
+	RangeFilter.SetRange(Block.Offset, Block.Num, SidePanel->RangeSelector->IsRangeChecked(Block.Range));
+	UpdateVisibleMask(Block.Offset, Block.Num);
+
+	// blocks which aren't published yet pick up the new state once they are
+	if (bIsPopulating && BlockIndex >= NumPublishedBlocks)
+		return false;
+
+	// the flat list holds the blocks in table order, the slice of this block starts at its prefix offset
+	int32 const Position = BlockListOffsets[BlockIndex];
+	int32 const OldNum = BlockListOffsets[BlockIndex + 1] - Position;
+
+	if (OldNum > 0)
+	{
+		CharacterWidgetsArray.RemoveAt(Position, OldNum);
+		Rows.Remove(Block.Range);
+	}
+
+	TArray<TSharedPtr<FUnicodeBrowserRow>> RowsFiltered;
+	FilterBlock(BlockIndex, RowsFiltered);
+	int32 const NewNum = RowsFiltered.Num();
+
+	if (NewNum > 0)
+	{
+		CharacterWidgetsArray.Insert(RowsFiltered, Position);
+		Rows.Add(Block.Range, MoveTemp(RowsFiltered));
+	}
+
+	// only the offsets of the following blocks move
+	for (int32 FollowingIndex = BlockIndex + 1; FollowingIndex < BlockListOffsets.Num(); ++FollowingIndex)
+	{
+		BlockListOffsets[FollowingIndex] += NewNum - OldNum;
+	}
+
+	return OldNum > 0 || NewNum > 0;
+}
+
+void SUnicodeBrowserWidget::UpdateBlockListOffsets()
+{
+	TConstArrayView<FUnicodeBrowserCodepointTable::FBlock> const Blocks = CodepointTable.IsValid() ? CodepointTable->GetBlocks() : TConstArrayView<FUnicodeBrowserCodepointTable::FBlock>();
+	BlockListOffsets.SetNumUninitialized(Blocks.Num() + 1);
+
+	int32 Offset = 0;
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		BlockListOffsets[BlockIndex] = Offset;
+		if (TArray<TSharedPtr<FUnicodeBrowserRow>> const* BlockRows = Rows.Find(Blocks[BlockIndex].Range))
 		{
-			Rows.Add(Range, RowsFiltered);
+			Offset += BlockRows->Num();
 		}
 	}
 
-	UpdateCharactersArray();
+	BlockListOffsets[Blocks.Num()] = Offset;
+}
+
+int32 SUnicodeBrowserWidget::GetListOffset(EUnicodeBlockRange const BlockRange) const
+{
+	int32 const BlockIndex = CodepointTable.IsValid() ? CodepointTable->FindBlockIndex(BlockRange) : INDEX_NONE;
+	if (BlockIndex == INDEX_NONE || !BlockListOffsets.IsValidIndex(BlockIndex + 1) || BlockListOffsets[BlockIndex] == BlockListOffsets[BlockIndex + 1])
+		return INDEX_NONE;
+
+	return BlockListOffsets[BlockIndex];
+}
+
+int32 SUnicodeBrowserWidget::GetBlockIndexAtListOffset(int32 const ListOffset) const
+{
+	if (ListOffset < 0 || BlockListOffsets.IsEmpty() || ListOffset >= BlockListOffsets.Last())
+		return INDEX_NONE;
+
+	// the last block starting at or before the offset, empty blocks share their offset with the following block and are skipped
+	// the search is bound by the amount of Unicode blocks, not by the amount of rows
+	return Algo::UpperBound(BlockListOffsets, ListOffset) - 1;
+}
+
+TOptional<EUnicodeBlockRange> SUnicodeBrowserWidget::GetBlockAtListOffset(int32 const ListOffset) const
+{
+	int32 const BlockIndex = GetBlockIndexAtListOffset(ListOffset);
+	if (BlockIndex == INDEX_NONE)
+		return {};
+
+	return CodepointTable->GetBlocks()[BlockIndex].Range;
+}
+
+TOptional<EUnicodeBlockRange> SUnicodeBrowserWidget::GetCurrentBlock() const
+{
+	if (!CharactersTileView.IsValid())
+		return {};
+
+	// the scroll offset of tile views is measured in items
+	return GetBlockAtListOffset(FMath::FloorToInt32(CharactersTileView->GetScrollOffset()));
+}
+
+bool SUnicodeBrowserWidget::ScrollToBlock(EUnicodeBlockRange const BlockRange)
+{
+	int32 const ListOffset = GetListOffset(BlockRange);
+	if (ListOffset == INDEX_NONE)
+		return false;
+
+	// we can't use animated scroll as the layout invalidation of the RangeWidgets would be to early
+	// see PR: https://github.com/EpicGames/UnrealEngine/pull/12580
+	CharactersTileView->SetScrollOffset(static_cast<float>(ListOffset));
+	return true;
+}
+
+bool SUnicodeBrowserWidget::ScrollToCodepoint(int32 const Codepoint)
+{
+	int32 const Index = CodepointTable.IsValid() ? CodepointTable->FindIndex(Codepoint) : INDEX_NONE;
+	int32 const BlockIndex = Index != INDEX_NONE ? CodepointTable->GetBlockIndex(Index) : INDEX_NONE;
+	if (!CodepointTable.IsValid() || !CodepointTable->GetBlocks().IsValidIndex(BlockIndex) || !BlockListOffsets.IsValidIndex(BlockIndex + 1))
+		return false;
+
+	// the slice of the block is ordered by table index
+	int32 const SliceStart = BlockListOffsets[BlockIndex];
+	TArrayView<TSharedPtr<FUnicodeBrowserRow> const> const Slice = MakeArrayView(CharacterWidgetsArray).Slice(SliceStart, BlockListOffsets[BlockIndex + 1] - SliceStart);
+	int32 const Position = Algo::LowerBoundBy(Slice, Index, [](TSharedPtr<FUnicodeBrowserRow> const& Row) { return Row->Index; });
+	if (!Slice.IsValidIndex(Position) || Slice[Position]->Index != Index)
+		return false;
+
+	CharactersTileView->SetScrollOffset(static_cast<float>(SliceStart + Position));
+	return true;
+}
+
+FText SUnicodeBrowserWidget::GetCurrentBlockText() const
+{
+	int32 const BlockIndex = CharactersTileView.IsValid() ? GetBlockIndexAtListOffset(FMath::FloorToInt32(CharactersTileView->GetScrollOffset())) : INDEX_NONE;
+	return BlockIndex != INDEX_NONE ? CodepointTable->GetBlocks()[BlockIndex].DisplayName : FText::GetEmpty();
+}
+
+void SUnicodeBrowserWidget::FilterBlock(int32 const BlockIndex, TArray<TSharedPtr<FUnicodeBrowserRow>>& OutRows) const
+{
+	FUnicodeBrowserCodepointTable::FBlock const& Block = CodepointTable->GetBlocks()[BlockIndex];
+	int32 const EndIndex = Block.Offset + Block.Num;
+
+	// measuring requires the font cache, only the remaining candidates of this block are measured (once per table)
+	bool const bHideZeroSize = !UUnicodeBrowserOptions::Get()->bShowZeroSize;
+	if (bHideZeroSize)
+	{
+		CodepointTable->EvaluateSizes(VisibleMask, Block.Offset, EndIndex);
+	}
+
+	TBitArray<> const& NonZeroSizeMask = CodepointTable->GetNonZeroSizeMask();
+	for (TConstSetBitIterator<> It(VisibleMask, Block.Offset); It && It.GetIndex() < EndIndex; ++It)
+	{
+		if (bHideZeroSize && !NonZeroSizeMask[It.GetIndex()])
+			continue;
+
+		OutRows.Add(CodepointTable->GetRow(It.GetIndex()));
+	}
 }
 
 void SUnicodeBrowserWidget::UpdateCharactersArray()
@@ -645,79 +1105,231 @@ void SUnicodeBrowserWidget::UpdateCharactersArray()
 
 void SUnicodeBrowserWidget::FilterByString(FString Needle)
 {
-	bool const bFilterTags = Needle.Len() > 0 && UUnicodeBrowserOptions::Get()->Preset && UUnicodeBrowserOptions::Get()->Preset->SupportsFont(CurrentFont);
+	if (!CodepointTable.IsValid())
+		return;
+
+	// cancels a running search, its result would be stale anyway
+	SearchGeneration->Increment();
 
-	// build an array which include all single character search terms
-	TArray<FString> CharacterNeedles;
-	Needle.ParseIntoArray(CharacterNeedles, TEXT(","));
-	for (int Idx = CharacterNeedles.Num() - 1; Idx >= 0; Idx--)
+	TSharedRef<FUnicodeBrowserQuery const> const Query = MakeShared<FUnicodeBrowserQuery const>(FUnicodeBrowserQuery::Parse(Needle));
+
+	bool const bFilterTags = UUnicodeBrowserOptions::Get()->Preset && UUnicodeBrowserOptions::Get()->Preset->SupportsFont(CurrentFont);
+	bool const bSearchNames = UUnicodeBrowserOptions::Get()->bSearch_CharacterNames;
+
+	// codepoint literals, properties and single characters are answered from the table right away
+	if (!Query->HasTextTerms() || (!bFilterTags && !bSearchNames))
 	{
-		CharacterNeedles[Idx].TrimStartAndEndInline();
-		if (CharacterNeedles[Idx].Len() > 1)
-		{
-			CharacterNeedles.RemoveAtSwap(Idx);
-		}
-	}
+		PendingSearch.Reset();
 
-	bool const bFilterByCharacter = CharacterNeedles.Num() > 0;
+		int32 const BestMatchesCount = UnicodeBrowser::BrowserWidget::GetBestMatchesCount();
 
-	bool const bCaseSensitive = UUnicodeBrowserOptions::Get()->bSearch_CaseSensitive;
+		TBitArray<> NewSearchFilter;
+		FUnicodeBrowserQuery::FScores Scores;
+		Query->Evaluate(*CodepointTable, nullptr, false, UUnicodeBrowserOptions::Get()->bSearch_CaseSensitive, [] { return false; }, NewSearchFilter, BestMatchesCount > 0 ? &Scores : nullptr);
 
-	bool bNeedUpdate = false;
+		TArray<int32> BestMatches;
+		UnicodeBrowser::BrowserWidget::SelectBestMatches(*CodepointTable, NewSearchFilter, Scores, BestMatchesCount, BestMatches);
+		ApplySearch(*Query, MoveTemp(NewSearchFilter), MoveTemp(BestMatches));
+	}
+	else if (bIsSearching)
+	{
+		// only the latest needle is of interest, it starts once the running search returned
+		PendingSearch = MoveTemp(Needle);
+	}
+	else
+	{
+		StartSearch(Query, bFilterTags, bSearchNames);
+	}
+}
 
-	TArray<int32> Whitelist;
-	if (bFilterTags)
+void SUnicodeBrowserWidget::GetSearchCompletions(FStringView const Prefix, TArray<FUnicodeBrowserTagTrie::FCompletion>& OutCompletions) const
+{
+	UDataAsset_FontTags const* Preset = UUnicodeBrowserOptions::Get()->Preset;
+	if (Preset && Preset->SupportsFont(CurrentFont))
 	{
-		Whitelist = UUnicodeBrowserOptions::Get()->Preset->GetCharactersByNeedle(Needle);
+		Preset->GetTagTrie()->FindCompletions(Prefix, OutCompletions);
 	}
+}
+
+void SUnicodeBrowserWidget::StartSearch(TSharedRef<FUnicodeBrowserQuery const> const& Query, bool const bFilterTags, bool const bSearchNames)
+{
+	bIsSearching = true;
 
-	for (auto& [Range, RawRangeRows] : RowsRaw)
+	// the index is an immutable snapshot of the preset, edits of the preset build a new one
+	TSharedPtr<FUnicodeBrowserTagIndex const> TagIndex;
+	if (bFilterTags)
 	{
-		bool bRangeHasMatch = false;
-		for (TSharedPtr<FUnicodeBrowserRow>& RowRaw : RawRangeRows)
-		{
-			bool bToggleRowState = Needle.IsEmpty() && RowRaw->bFilteredByTag;
+		TagIndex = UUnicodeBrowserOptions::Get()->Preset->GetTagIndex();
+	}
+
+	int32 const Generation = SearchGeneration->GetValue();
+	bool const bCaseSensitive = UUnicodeBrowserOptions::Get()->bSearch_CaseSensitive;
+	int32 const BestMatchesCount = UnicodeBrowser::BrowserWidget::GetBestMatchesCount();
 
-			if (!bToggleRowState && bFilterTags)
+	// the table is only read by the query, its layout never changes
+	Async(
+		EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakPtr<SUnicodeBrowserWidget>(SharedThis(this)), Query, Table = CodepointTable.ToSharedRef(), TagIndex = MoveTemp(TagIndex), bSearchNames, bCaseSensitive, BestMatchesCount, Session = SearchSession, Counter = SearchGeneration, Generation]()
+		{
+			if (TagIndex.IsValid())
 			{
-				bToggleRowState |= !Whitelist.Contains(RowRaw->Codepoint) != RowRaw->bFilteredByTag;
+				Session->Begin(TagIndex.ToSharedRef());
 			}
 
-			if (!bToggleRowState && bFilterByCharacter)
+			TBitArray<> Mask;
+			FUnicodeBrowserQuery::FScores Scores;
+			bool const bCompleted = Query->Evaluate(
+				*Table,
+				TagIndex.IsValid() ? &Session.Get() : nullptr,
+				bSearchNames,
+				bCaseSensitive,
+				[&Counter, Generation] { return Counter->GetValue() != Generation; },
+				Mask,
+				BestMatchesCount > 0 ? &Scores : nullptr
+			);
+
+			TArray<int32> BestMatches;
+			if (bCompleted)
 			{
-				bool const bMatchesCharacter = CharacterNeedles.ContainsByPredicate(
-					[bCaseSensitive, RowRaw](FString const& CharacterNeedle)
+				if (TagIndex.IsValid())
+				{
+					Session->Commit();
+				}
+
+				UnicodeBrowser::BrowserWidget::SelectBestMatches(*Table, Mask, Scores, BestMatchesCount, BestMatches);
+			}
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[WeakThis, Query, Generation, bCompleted, Mask = MoveTemp(Mask), BestMatches = MoveTemp(BestMatches)]() mutable
+				{
+					if (TSharedPtr<SUnicodeBrowserWidget> const Widget = WeakThis.Pin())
 					{
-						return CharacterNeedle.Equals(RowRaw->Character, bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase);
+						Widget->OnSearchFinished(*Query, Generation, bCompleted ? &Mask : nullptr, MoveTemp(BestMatches));
 					}
-				);
+				}
+			);
+		}
+	);
+}
 
-				bToggleRowState |= !bMatchesCharacter != RowRaw->bFilteredByTag;
-			}
+void SUnicodeBrowserWidget::OnSearchFinished(FUnicodeBrowserQuery const& Query, int32 const Generation, TBitArray<>* Mask, TArray<int32> BestMatches)
+{
+	bIsSearching = false;
 
-			if (bToggleRowState)
+	if (PendingSearch.IsSet())
+	{
+		FString NextNeedle = PendingSearch.GetValue();
+		PendingSearch.Reset();
+		FilterByString(MoveTemp(NextNeedle));
+		return;
+	}
+
+	// a new table or query bumps the generation, so the mask always fits the current table
+	if (Generation != SearchGeneration->GetValue() || !Mask)
+		return;
+
+	ApplySearch(Query, MoveTemp(*Mask), MoveTemp(BestMatches));
+}
+
+void SUnicodeBrowserWidget::ApplySearch(FUnicodeBrowserQuery const& Query, TBitArray<> NewSearchFilter, TArray<int32> BestMatches)
+{
+	if (!CodepointTable.IsValid() || NewSearchFilter.Num() != CodepointTable->Num())
+		return;
+
+	if (NewSearchFilter != SearchFilter)
+	{
+		SearchFilter = MoveTemp(NewSearchFilter);
+
+		// ensure that the blocks with matches are selected before UpdateCharacters() is updating the filtered list
+		if (!Query.IsEmpty() && UUnicodeBrowserOptions::Get()->bSearch_AutoSetRange)
+		{
+			// one match per block is enough, the scan continues at the start of the following block
+			for (int32 StartIndex = 0; StartIndex < SearchFilter.Num();)
 			{
-				RowRaw->bFilteredByTag = !RowRaw->bFilteredByTag;
-				bNeedUpdate = true;
-				bRangeHasMatch = true;
+				TConstSetBitIterator<> const It(SearchFilter, StartIndex);
+				if (!It)
+					break;
+
+				int32 const BlockIndex = CodepointTable->GetBlockIndex(It.GetIndex());
+				if (!CodepointTable->GetBlocks().IsValidIndex(BlockIndex))
+				{
+					StartIndex = It.GetIndex() + 1;
+					continue;
+				}
+
+				FUnicodeBrowserCodepointTable::FBlock const& Block = CodepointTable->GetBlocks()[BlockIndex];
+				if (!SidePanel->RangeSelector->IsRangeChecked(Block.Range))
+				{
+					SidePanel->RangeSelector->SetRanges({Block.Range}, false);
+				}
+
+				StartIndex = Block.Offset + Block.Num;
 			}
 		}
 
-		// ensure that the necessary ranges are selected before UpdateCharacters() is updating the filtered list
-		if (bRangeHasMatch && UUnicodeBrowserOptions::Get()->bSearch_AutoSetRange)
+		UpdateCharacters();
+		CharactersTileView->RebuildList();
+	}
+
+	UpdateBestMatches(BestMatches);
+
+	// a lookup of a single codepoint jumps right to it
+	if (TOptional<int32> const Codepoint = Query.GetSingleCodepoint())
+	{
+		ScrollToCodepoint(Codepoint.GetValue());
+	}
+}
+
+void SUnicodeBrowserWidget::UpdateBestMatches(TConstArrayView<int32> const Codepoints)
+{
+	BestMatchRows.Reset();
+
+	bool const bHideZeroSize = !UUnicodeBrowserOptions::Get()->bShowZeroSize;
+	for (int32 const Codepoint : Codepoints)
+	{
+		int32 const Index = CodepointTable->FindIndex(Codepoint);
+		if (Index == INDEX_NONE || !SearchFilter[Index])
+			continue;
+
+		if (bHideZeroSize)
 		{
-			if (!SidePanel->RangeSelector->IsRangeChecked(Range))
-			{
-				SidePanel->RangeSelector->SetRanges({Range}, false);
-			}
+			CodepointTable->EvaluateSizes(SearchFilter, Index, Index + 1);
+			if (!CodepointTable->GetNonZeroSizeMask()[Index])
+				continue;
 		}
+
+		BestMatchRows.Add(CodepointTable->GetRow(Index));
 	}
 
-	if (bNeedUpdate)
+	RebuildBestMatches();
+}
+
+void SUnicodeBrowserWidget::RebuildBestMatches()
+{
+	if (!BestMatchesBox.IsValid())
+		return;
+
+	BestMatchesBox->ClearChildren();
+	for (TSharedPtr<FUnicodeBrowserRow> const& Row : BestMatchRows)
 	{
-		UpdateCharacters();
-		CharactersTileView->RebuildList();
+		BestMatchesBox->AddSlot()
+		[
+			SNew(SUnicodeCharacterGridEntry)
+			.FontInfo(CurrentFont)
+			.UnicodeCharacter(Row)
+			.OnMouseMove(this, &SUnicodeBrowserWidget::OnCharacterMouseMove, Row)
+			.OnZoomFontSize(this, &SUnicodeBrowserWidget::HandleZoomFont)
+			.OnZoomCellPadding(this, &SUnicodeBrowserWidget::HandleZoomPadding)
+		];
 	}
+
+	BestMatchesBox->ScrollToStart();
+}
+
+EVisibility SUnicodeBrowserWidget::GetBestMatchesVisibility() const
+{
+	return BestMatchRows.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
 }
 
 FReply SUnicodeBrowserWidget::OnCharacterMouseMove(FGeometry const& Geometry, FPointerEvent const& PointerEvent, TSharedPtr<FUnicodeBrowserRow> Row)
@@ -725,7 +1337,7 @@ FReply SUnicodeBrowserWidget::OnCharacterMouseMove(FGeometry const& Geometry, FP
 	if (CurrentRow == Row) return FReply::Unhandled();
 	CurrentRow = Row;
 
-	OnCharacterHighlight.ExecuteIfBound(Row.Get());
+	OnCharacterHighlight.ExecuteIfBound(Row);
 	return FReply::Handled();
 }
 
@@ -8,12 +8,16 @@
 
 #include "Fonts/UnicodeBlockRange.h"
 
+#include "UnicodeBrowser/UnicodeBrowserSearchSession.h"
+
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/SUbSearchBar.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Views/STileView.h"
 
 class UToolMenu;
+class FUnicodeBrowserCodepointTable;
+class FUnicodeBrowserQuery;
 class FUnicodeBrowserRow;
 class IDetailsView;
 class SCheckBoxList;
@@ -42,7 +46,7 @@ public:
 	SLATE_BEGIN_ARGS(SUnicodeBrowserWidget) {}
 	SLATE_END_ARGS()
 
-	DECLARE_DELEGATE_OneParam(FHighlightCharacter, FUnicodeBrowserRow*)
+	DECLARE_DELEGATE_OneParam(FHighlightCharacter, TSharedPtr<FUnicodeBrowserRow>)
 	FHighlightCharacter OnCharacterHighlight;
 
 	DECLARE_MULTICAST_DELEGATE_OneParam(FFontChanged, FSlateFontInfo*)
@@ -50,7 +54,7 @@ public:
 
 	FSlateFontInfo DefaultFont = FCoreStyle::GetDefaultFontStyle("Regular", 18);
 
-	TMap<EUnicodeBlockRange, TArray<TSharedPtr<FUnicodeBrowserRow>>> RowsRaw; // a raw list of all characters for the current font
+	TSharedPtr<FUnicodeBrowserCodepointTable> CodepointTable; // a raw table of all characters for the current font
 	TMap<EUnicodeBlockRange, TArray<TSharedPtr<FUnicodeBrowserRow>>> Rows; // a filtered view of the raw data, those are the characters that a
 
 	bool bShouldDisableThrottle = false;
@@ -59,6 +63,22 @@ public:
 
 public:
 	void Construct(FArguments const& InArgs);
+
+	// index of the first visible row of the block within the tile view, INDEX_NONE if the block has no visible rows
+	int32 GetListOffset(EUnicodeBlockRange BlockRange) const;
+
+	// block of the row at the given index of the tile view
+	TOptional<EUnicodeBlockRange> GetBlockAtListOffset(int32 ListOffset) const;
+
+	// block of the topmost row within the viewport
+	TOptional<EUnicodeBlockRange> GetCurrentBlock() const;
+
+	// scrolls the first row of the block to the top, returns false if the block has no visible rows
+	bool ScrollToBlock(EUnicodeBlockRange BlockRange);
+
+	// scrolls to the row of the codepoint, returns false if it isn't listed
+	bool ScrollToCodepoint(int32 Codepoint);
+
 	virtual ~SUnicodeBrowserWidget() override;
 
 	void MarkDirty(uint8 Flags);
@@ -76,12 +96,65 @@ protected:
 	mutable TSharedPtr<FUnicodeBrowserRow> CurrentRow;
 	FSlateFontInfo CurrentFont = DefaultFont;
 
+	// tables are built in the background by the font data subsystem, every new request increments the generation which drops stale results
+	int32 PopulateGeneration = 0;
+	bool bIsRequestingTable = false; // a table is built in the background, the current table stays as it is until the new one arrives
+	bool bIsPopulating = false; // the blocks of the CodepointTable are being published into the tile view
+	int32 NumPublishedBlocks = 0; // blocks of the CodepointTable which are already published into the tile view
+
+	// filter dimensions in table space, one bit per index of the CodepointTable
+	// the visible rows are the AND of all dimensions, the zero size filter is evaluated lazily per block (see FilterBlock)
+	TBitArray<> RangeFilter; // the index belongs to a selected range
+	TBitArray<> SearchFilter; // the index matches the current search, all bits are set without a search
+	TBitArray<> VisibleMask;
+
+	// tag and name searches run on a worker thread, one at a time, every new query increments the generation which cancels the running search
+	TSharedRef<FUnicodeBrowserSearchSession> SearchSession = MakeShared<FUnicodeBrowserSearchSession>(); // refines the previous tag matches while a needle is extended
+	TSharedRef<FThreadSafeCounter> SearchGeneration = MakeShared<FThreadSafeCounter>();
+	bool bIsSearching = false;
+	TOptional<FString> PendingSearch; // the latest needle which arrived while a search was running
+
+	// the most relevant matches of the current text search, best first, shown in a strip above the grid
+	TArray<TSharedPtr<FUnicodeBrowserRow>> BestMatchRows;
+	TSharedPtr<SScrollBox> BestMatchesBox;
+
+	TSet<EUnicodeBlockRange> PendingRangeToggles; // ranges which were toggled since the last ApplyRangeSelection
+
+	// prefix offsets of the block slices within CharacterWidgetsArray, one entry per block of the CodepointTable plus the total
+	TArray<int32> BlockListOffsets;
+
 protected:
 	void PopulateSupportedCharacters();
+	void OnCodepointTablePopulated(TSharedRef<FUnicodeBrowserCodepointTable> const& Table, bool bStream);
+	void PublishBlocks(double TimeBudget);
+	TOptional<float> GetPopulateProgress() const;
+
 	void UpdateCharacters();
 	void UpdateCharactersArray();
+	void UpdateRangeFilter();
+	void UpdateVisibleMask();
+	void UpdateVisibleMask(int32 StartIndex, int32 Count);
+
+	// range toggles are collected and applied once per tick, a few toggles only splice the slices of their blocks
+	void OnRangeToggled(EUnicodeBlockRange Range);
+	void ApplyRangeSelection();
+	bool SpliceBlock(int32 BlockIndex);
+
+	void UpdateBlockListOffsets();
+	int32 GetBlockIndexAtListOffset(int32 ListOffset) const;
+	FText GetCurrentBlockText() const;
+	void FilterBlock(int32 BlockIndex, TArray<TSharedPtr<FUnicodeBrowserRow>>& OutRows) const;
 
 	void FilterByString(FString Needle);
+	void GetSearchCompletions(FStringView Prefix, TArray<FUnicodeBrowserTagTrie::FCompletion>& OutCompletions) const;
+	void StartSearch(TSharedRef<FUnicodeBrowserQuery const> const& Query, bool bFilterTags, bool bSearchNames);
+	void OnSearchFinished(FUnicodeBrowserQuery const& Query, int32 Generation, TBitArray<>* Mask, TArray<int32> BestMatches);
+	void ApplySearch(FUnicodeBrowserQuery const& Query, TBitArray<> NewSearchFilter, TArray<int32> BestMatches);
+
+	// the strip ignores the range selection, but leaves out characters without a glyph just like the grid
+	void UpdateBestMatches(TConstArrayView<int32> Codepoints);
+	void RebuildBestMatches();
+	EVisibility GetBestMatchesVisibility() const;
 
 	FReply OnCharacterMouseMove(FGeometry const& Geometry, FPointerEvent const& PointerEvent, TSharedPtr<FUnicodeBrowserRow> Row);
 	void OnCharactersTileViewScrolled(double X);
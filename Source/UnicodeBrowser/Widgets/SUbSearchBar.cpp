@@ -2,11 +2,19 @@
 
 #include "ToolMenus.h"
 
+#include "Styling/AppStyle.h"
+
 #include "UnicodeBrowser/UnicodeBrowserOptions.h"
 
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SMenuAnchor.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
 void SUbSearchBar::Construct(FArguments const& InArgs)
 {
 	OnTextChanged = InArgs._OnTextChanged;
+	OnGetCompletions = InArgs._OnGetCompletions;
 
 	SSearchBox::Construct(
 		SSearchBox::FArguments()
@@ -19,6 +27,196 @@ void SUbSearchBar::Construct(FArguments const& InArgs)
 			}
 		)
 	);
+
+	// the completions drop down below the text box, without taking the focus from it
+	TSharedRef<SWidget> const TextBox = ChildSlot.GetWidget();
+	ChildSlot
+	[
+		SAssignNew(CompletionsAnchor, SMenuAnchor)
+		.Placement(MenuPlacement_ComboBox)
+		.Method(EPopupMethod::UseCurrentWindow)
+		.MenuContent(
+			SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("Menu.Background"))
+			.Padding(2)
+			[
+				SNew(SBox)
+				.MinDesiredWidth(300)
+				.MaxDesiredHeight(240)
+				[
+					SAssignNew(CompletionsList, SListView<FCompletionItem>)
+					.ListItemsSource(&CompletionItems)
+					.SelectionMode(ESelectionMode::Single)
+					.OnGenerateRow(this, &SUbSearchBar::GenerateCompletionRow)
+					.OnMouseButtonClick(this, &SUbSearchBar::AcceptCompletion)
+				]
+			]
+		)
+		[
+			TextBox
+		]
+	];
+}
+
+void SUbSearchBar::Tick(FGeometry const& AllottedGeometry, double const InCurrentTime, float const InDeltaTime)
+{
+	SSearchBox::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	FText const CurrentText = GetText();
+	FString const& Text = CurrentText.ToString();
+	if (!Text.Equals(CompletedText, ESearchCase::CaseSensitive))
+	{
+		CompletedText = Text;
+		UpdateCompletions();
+	}
+}
+
+FReply SUbSearchBar::OnPreviewKeyDown(FGeometry const& MyGeometry, FKeyEvent const& InKeyEvent)
+{
+	if (!CompletionsAnchor->IsOpen())
+		return SSearchBox::OnPreviewKeyDown(MyGeometry, InKeyEvent);
+
+	FKey const Key = InKeyEvent.GetKey();
+	if (Key == EKeys::Up || Key == EKeys::Down)
+	{
+		TArray<FCompletionItem> const Selection = CompletionsList->GetSelectedItems();
+		int32 SelectedIndex = Selection.IsEmpty() ? INDEX_NONE : CompletionItems.IndexOfByKey(Selection[0]);
+		SelectedIndex = Key == EKeys::Down ? (SelectedIndex + 1) % CompletionItems.Num() : (SelectedIndex <= 0 ? CompletionItems.Num() - 1 : SelectedIndex - 1);
+
+		CompletionsList->SetSelection(CompletionItems[SelectedIndex], ESelectInfo::OnNavigation);
+		CompletionsList->RequestScrollIntoView(CompletionItems[SelectedIndex]);
+		return FReply::Handled();
+	}
+
+	if (Key == EKeys::Tab || (Key == EKeys::Enter && CompletionsList->GetNumItemsSelected() > 0))
+	{
+		TArray<FCompletionItem> const Selection = CompletionsList->GetSelectedItems();
+		AcceptCompletion(Selection.IsEmpty() ? CompletionItems[0] : Selection[0]);
+		return FReply::Handled();
+	}
+
+	if (Key == EKeys::Escape)
+	{
+		CloseCompletions();
+		return FReply::Handled();
+	}
+
+	return SSearchBox::OnPreviewKeyDown(MyGeometry, InKeyEvent);
+}
+
+int32 SUbSearchBar::FindTermStart(FString const& Text)
+{
+	int32 TermStart = 0;
+	int32 WordStart = INDEX_NONE;
+	for (int32 Position = 0; Position <= Text.Len(); ++Position)
+	{
+		TCHAR const Character = Position < Text.Len() ? Text[Position] : TEXT(' ');
+		if (Character == TEXT(',') || Character == TEXT('(') || Character == TEXT(')') || Character == TEXT('"'))
+		{
+			TermStart = Position + 1;
+			WordStart = INDEX_NONE;
+		}
+		else if (FChar::IsWhitespace(Character))
+		{
+			// operators are uppercase words, anything else continues the term
+			if (WordStart != INDEX_NONE)
+			{
+				FStringView const Word = FStringView(Text).Mid(WordStart, Position - WordStart);
+				if (Word.Equals(TEXT("AND"), ESearchCase::CaseSensitive) || Word.Equals(TEXT("OR"), ESearchCase::CaseSensitive) || Word.Equals(TEXT("NOT"), ESearchCase::CaseSensitive))
+				{
+					TermStart = Position + 1;
+				}
+
+				WordStart = INDEX_NONE;
+			}
+		}
+		else if (WordStart == INDEX_NONE)
+		{
+			WordStart = Position;
+		}
+	}
+
+	return FMath::Min(TermStart, Text.Len());
+}
+
+void SUbSearchBar::UpdateCompletions()
+{
+	CompletionItems.Reset();
+
+	FStringView const Term = FStringView(CompletedText).Mid(FindTermStart(CompletedText)).TrimStart();
+	if (HasKeyboardFocus() && !Term.IsEmpty() && UUnicodeBrowserOptions::Get()->bSearch_TagCompletions)
+	{
+		TArray<FUnicodeBrowserTagTrie::FCompletion> Completions;
+		OnGetCompletions.ExecuteIfBound(Term, Completions);
+
+		for (FUnicodeBrowserTagTrie::FCompletion& Completion : Completions)
+		{
+			CompletionItems.Add(MakeShared<FUnicodeBrowserTagTrie::FCompletion>(MoveTemp(Completion)));
+		}
+	}
+
+	CompletionsList->RequestListRefresh();
+	CompletionsList->ClearSelection();
+
+	if (CompletionItems.IsEmpty())
+	{
+		CompletionsAnchor->SetIsOpen(false);
+	}
+	else if (!CompletionsAnchor->IsOpen())
+	{
+		CompletionsAnchor->SetIsOpen(true, false);
+	}
+}
+
+void SUbSearchBar::AcceptCompletion(FCompletionItem const Item)
+{
+	if (!Item.IsValid())
+		return;
+
+	// the whitespace in front of the term is kept, tags with separators have to be quoted to stay a single term
+	int32 const TermStart = FindTermStart(CompletedText);
+	int32 const TagStart = CompletedText.Len() - FStringView(CompletedText).Mid(TermStart).TrimStart().Len();
+
+	FString const& Tag = Item->Tag;
+	bool const bQuote = Tag.Contains(TEXT(",")) || Tag.Contains(TEXT("(")) || Tag.Contains(TEXT(")"));
+	FString const NewText = CompletedText.Left(TagStart) + (bQuote ? FString::Printf(TEXT("\"%s\""), *Tag.Replace(TEXT("\""), TEXT(""))) : Tag);
+
+	// accepting isn't typing, the completions stay closed until the text changes again
+	CompletedText = NewText;
+	CloseCompletions();
+
+	SetText(FText::FromString(NewText));
+	TriggerUpdate();
+}
+
+void SUbSearchBar::CloseCompletions()
+{
+	CompletionItems.Reset();
+	CompletionsList->RequestListRefresh();
+	CompletionsAnchor->SetIsOpen(false);
+}
+
+TSharedRef<ITableRow> SUbSearchBar::GenerateCompletionRow(FCompletionItem const Item, TSharedRef<STableViewBase> const& OwnerTable) const
+{
+	return SNew(STableRow<FCompletionItem>, OwnerTable)
+		.Padding(FMargin(4, 2))
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Item->Tag))
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8, 0, 0, 0)
+			[
+				SNew(STextBlock)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				.Text(FText::AsNumber(Item->NumGlyphs))
+			]
+		];
 }
 
 UToolMenu* SUbSearchBar::CreateMenuSection_Settings() const
@@ -75,5 +273,76 @@ UToolMenu* SUbSearchBar::CreateMenuSection_Settings() const
 		);
 	}
 
+	{
+		FUIAction const Action(
+			FExecuteAction::CreateLambda(
+				[this]()
+				{
+					UUnicodeBrowserOptions::Get()->bSearch_CharacterNames = !UUnicodeBrowserOptions::Get()->bSearch_CharacterNames;
+					UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
+					TriggerUpdate();
+				}
+			),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateLambda([this]() { return UUnicodeBrowserOptions::Get()->bSearch_CharacterNames; })
+		);
+
+		SettingsMenu.AddMenuEntry(
+			"CharacterNames",
+			INVTEXT("Character Names"),
+			INVTEXT("Search the official Unicode character names too\nThis works without a preset, words may be given in any order"),
+			FSlateIcon(),
+			Action,
+			EUserInterfaceActionType::ToggleButton
+		);
+	}
+
+	{
+		FUIAction const Action(
+			FExecuteAction::CreateLambda(
+				[this]()
+				{
+					UUnicodeBrowserOptions::Get()->bSearch_BestMatches = !UUnicodeBrowserOptions::Get()->bSearch_BestMatches;
+					UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
+					TriggerUpdate();
+				}
+			),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateLambda([this]() { return UUnicodeBrowserOptions::Get()->bSearch_BestMatches; })
+		);
+
+		SettingsMenu.AddMenuEntry(
+			"BestMatches",
+			INVTEXT("Best Matches"),
+			INVTEXT("List the most relevant matches above the grid\nExact tags rank first, then tags with a word starting with the search, character names and other substrings"),
+			FSlateIcon(),
+			Action,
+			EUserInterfaceActionType::ToggleButton
+		);
+	}
+
+	{
+		FUIAction const Action(
+			FExecuteAction::CreateLambda(
+				[this]()
+				{
+					UUnicodeBrowserOptions::Get()->bSearch_TagCompletions = !UUnicodeBrowserOptions::Get()->bSearch_TagCompletions;
+					UUnicodeBrowserOptions::Get()->TryUpdateDefaultConfigFile();
+				}
+			),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateLambda([this]() { return UUnicodeBrowserOptions::Get()->bSearch_TagCompletions; })
+		);
+
+		SettingsMenu.AddMenuEntry(
+			"TagCompletions",
+			INVTEXT("Tag Completions"),
+			INVTEXT("Suggest the tags of the preset which start with the term being typed\nTab or Enter accepts a suggestion, the tags with the most characters come first"),
+			FSlateIcon(),
+			Action,
+			EUserInterfaceActionType::ToggleButton
+		);
+	}
+
 	return Menu;
 }
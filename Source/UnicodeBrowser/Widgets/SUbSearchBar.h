@@ -2,8 +2,12 @@
 
 #include "Framework/Application/SlateApplication.h"
 
+#include "UnicodeBrowser/UnicodeBrowserTagTrie.h"
+
 #include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SListView.h"
 
+class SMenuAnchor;
 class UToolMenu;
 
 class SUbSearchBar : public SSearchBox
@@ -12,14 +16,20 @@ class SUbSearchBar : public SSearchBox
 
 public:
 	DECLARE_DELEGATE_OneParam(FOnTextChanged, FString)
+	DECLARE_DELEGATE_TwoParams(FOnGetCompletions, FStringView /* Prefix */, TArray<FUnicodeBrowserTagTrie::FCompletion>& /* OutCompletions */)
 
 	SLATE_BEGIN_ARGS(SUbSearchBar) {}
 		SLATE_EVENT(FOnTextChanged, OnTextChanged)
+		SLATE_EVENT(FOnGetCompletions, OnGetCompletions)
 	SLATE_END_ARGS()
 
 	void Construct(FArguments const& InArgs);
 
+	virtual void Tick(FGeometry const& AllottedGeometry, double InCurrentTime, float InDeltaTime) override;
+	virtual FReply OnPreviewKeyDown(FGeometry const& MyGeometry, FKeyEvent const& InKeyEvent) override;
+
 	FOnTextChanged OnTextChanged;
+	FOnGetCompletions OnGetCompletions;
 
 protected:
 	void TriggerUpdate() const
@@ -29,4 +39,21 @@ protected:
 	}
 
 	UToolMenu* CreateMenuSection_Settings() const;
+
+private:
+	using FCompletionItem = TSharedPtr<FUnicodeBrowserTagTrie::FCompletion>;
+
+	// start of the term which is being typed, i.e. the text after the last separator or operator (see FUnicodeBrowserQuery)
+	static int32 FindTermStart(FString const& Text);
+
+	// completions are looked up on every keystroke, the change notifications of the search box are delayed while typing
+	void UpdateCompletions();
+	void AcceptCompletion(FCompletionItem Item);
+	void CloseCompletions();
+	TSharedRef<ITableRow> GenerateCompletionRow(FCompletionItem Item, TSharedRef<STableViewBase> const& OwnerTable) const;
+
+	TSharedPtr<SMenuAnchor> CompletionsAnchor;
+	TSharedPtr<SListView<FCompletionItem>> CompletionsList;
+	TArray<FCompletionItem> CompletionItems;
+	FString CompletedText; // the text which the completions belong to
 };
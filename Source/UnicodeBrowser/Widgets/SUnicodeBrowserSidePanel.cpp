@@ -5,6 +5,7 @@
 #include "SlateOptMacros.h"
 
 #include "HAL/PlatformApplicationMisc.h"
+#include "UnicodeBrowser/UnicodeBrowserCodepointTable.h"
 #include "UnicodeBrowser/UnicodeBrowserStatic.h"
 
 #include "UnicodeBrowser/UnicodeBrowserWidget.h"
@@ -46,7 +47,7 @@ void SUnicodeBrowserSidePanel::Construct(FArguments const& InArgs)
 						if (!UnicodeBrowser.IsValid())
 							return FReply::Unhandled();
 
-						FPlatformApplicationMisc::ClipboardCopy(*UnicodeBrowser.Pin().Get()->CurrentRow->Character);
+						FPlatformApplicationMisc::ClipboardCopy(*UnicodeBrowser.Pin().Get()->CurrentRow->GetCharacter());
 						return FReply::Handled();
 					}
 				)
@@ -55,10 +56,10 @@ void SUnicodeBrowserSidePanel::Construct(FArguments const& InArgs)
 				.IsEnabled(true)
 				.ToolTipText(
 					FText::FromString(
-						FString::Printf(TEXT("Char Code: U+%-06.04X. Double-Click to copy: %s."), UnicodeBrowser.Pin().Get()->CurrentRow->Codepoint, *UnicodeBrowser.Pin().Get()->CurrentRow->Character)
+						FString::Printf(TEXT("Char Code: U+%-06.04X. Double-Click to copy: %s."), UnicodeBrowser.Pin().Get()->CurrentRow->GetCodepoint(), *UnicodeBrowser.Pin().Get()->CurrentRow->GetCharacter())
 					)
 				)
-				.Text(FText::FromString(FString::Printf(TEXT("%s"), *UnicodeBrowser.Pin().Get()->CurrentRow->Character)))
+				.Text(FText::FromString(FString::Printf(TEXT("%s"), *UnicodeBrowser.Pin().Get()->CurrentRow->GetCharacter())))
 			]
 		]
 		+ SSplitter::Slot()
@@ -105,14 +106,16 @@ void SUnicodeBrowserSidePanel::Construct(FArguments const& InArgs)
 
 	UnicodeBrowser.Pin().Get()->OnCharacterHighlight.BindSPLambda(
 		CurrentCharacterView.Get(),
-		[this](FUnicodeBrowserRow* CharacterInfo)
+		[this](TSharedPtr<FUnicodeBrowserRow> CharacterInfo)
 		{
+			FString const Character = CharacterInfo->GetCharacter();
+
 			// update the preview glyph/tooltip
-			CurrentCharacterView->SetText(FText::FromString(CharacterInfo->Character));
-			CurrentCharacterView->SetToolTipText(FText::FromString(FString::Printf(TEXT("Char Code: U+%-06.04X. Double-Click to copy: %s."), CharacterInfo->Codepoint, *CharacterInfo->Character)));
+			CurrentCharacterView->SetText(FText::FromString(Character));
+			CurrentCharacterView->SetToolTipText(FText::FromString(FString::Printf(TEXT("Char Code: U+%-06.04X. Double-Click to copy: %s."), CharacterInfo->GetCodepoint(), *Character)));
 
 			// update the glyph details
-			CurrentCharacterDetails->SetRow(CharacterInfo->AsShared());
+			CurrentCharacterDetails->SetRow(CharacterInfo);
 		}
 	);
 
@@ -135,29 +138,26 @@ TSharedRef<SExpandableArea> SUnicodeBrowserSidePanel::MakeBlockRangesSidebar()
 		{
 			if (UnicodeBrowser.IsValid() && UnicodeBrowser.Pin().Get()->CharactersTileView.IsValid())
 			{
-				if (TArray<TSharedPtr<FUnicodeBrowserRow>>* RangeCharacters = UnicodeBrowser.Pin().Get()->Rows.Find(BlockRange))
-				{
-					if (RangeCharacters->Num() > 0)
-					{
-						// we scroll to the first character within that range
-						TSharedPtr<FUnicodeBrowserRow> const& Character = (*RangeCharacters)[0];
-
-						// we can't use animated scroll as the layout invalidation of the RangeWidgets would be to early
-						// see PR: https://github.com/EpicGames/UnrealEngine/pull/12580
-						UnicodeBrowser.Pin().Get()->CharactersTileView->RequestScrollIntoView(Character);
-					}
-				}
+				// we scroll to the first character within that range
+				UnicodeBrowser.Pin()->ScrollToBlock(BlockRange);
 			}
 		}
 	);
 
+	RangeSelector->OnRangeStateChanged.BindSPLambda(
+		this,
+		[this](EUnicodeBlockRange const Range, bool)
+		{
+			UnicodeBrowser.Pin()->OnRangeToggled(Range);
+		}
+	);
+
 	// this method gets called a tick late, so that a preset can modify multiple states and the character list will only be updated once
 	RangeSelector->OnRangeSelectionChanged.BindSPLambda(
 		this,
 		[this]()
 		{
-			UnicodeBrowser.Pin()->UpdateCharacters();
-			UnicodeBrowser.Pin()->CharactersTileView->RebuildList();
+			UnicodeBrowser.Pin()->ApplyRangeSelection();
 		}
 	);
 
@@ -188,7 +188,7 @@ TSharedRef<SExpandableArea> SUnicodeBrowserSidePanel::MakeBlockRangesSidebar()
 					{
 						if (UnicodeBrowser.IsValid())
 						{
-							SelectAllRangesWithCharacters(UnicodeBrowser.Pin()->RowsRaw);
+							SelectAllRangesWithCharacters(UnicodeBrowser.Pin()->CodepointTable);
 						}
 						return FReply::Handled();
 					}
@@ -223,12 +223,15 @@ TSharedRef<SExpandableArea> SUnicodeBrowserSidePanel::MakeBlockRangesSidebar()
 		];
 }
 
-void SUnicodeBrowserSidePanel::SelectAllRangesWithCharacters(TMap<EUnicodeBlockRange, TArray<TSharedPtr<FUnicodeBrowserRow>>>& Rows, bool const bExclusive) const
+void SUnicodeBrowserSidePanel::SelectAllRangesWithCharacters(TSharedPtr<FUnicodeBrowserCodepointTable> const& Table, bool const bExclusive) const
 {
+	if (!Table.IsValid())
+		return;
+
 	TArray<EUnicodeBlockRange> Ranges;
-	for (auto const& [Range, Characters] : Rows)
+	for (FUnicodeBrowserCodepointTable::FBlock const& Block : Table->GetBlocks())
 	{
-		if (!Characters.IsEmpty()) Ranges.Add(Range);
+		if (Block.NumCovered > 0) Ranges.Add(Block.Range);
 	}
 	RangeSelector->SetRanges(Ranges, bExclusive);
 }
@@ -8,6 +8,7 @@
 
 #include "Widgets/Layout/SSplitter.h"
 
+class FUnicodeBrowserCodepointTable;
 class SExpandableArea;
 class STextBlock;
 /**
@@ -30,8 +31,8 @@ protected:
 	TSharedPtr<SUnicodeCharacterInfo> CurrentCharacterDetails;
 	TSharedPtr<SUnicodeBlockRangeSelector> RangeSelector;
 
-	/* @param Rows The set which should be evaluated when checking for entries
+	/* @param Table The codepoint table which should be evaluated when checking for entries
 	 * @param bExclusive Should all other ranges be disabled? */
-	void SelectAllRangesWithCharacters(TMap<EUnicodeBlockRange, TArray<TSharedPtr<FUnicodeBrowserRow>>> &Rows, bool bExclusive = true) const;
+	void SelectAllRangesWithCharacters(TSharedPtr<FUnicodeBrowserCodepointTable> const& Table, bool bExclusive = true) const;
 	TSharedRef<SExpandableArea> MakeBlockRangesSidebar();
 };
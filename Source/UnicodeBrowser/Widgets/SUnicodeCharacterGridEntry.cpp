@@ -46,7 +46,7 @@ void SUnicodeCharacterGridEntry::Construct(FArguments const& InArgs)
 		.Font(InArgs._FontInfo)
 		.IsEnabled(true)
 		.Justification(ETextJustify::Center)
-		.Text(FText::FromString(*UnicodeCharacter->Character))
+		.Text(FText::FromString(UnicodeCharacter->GetCharacter()))
 		.Visibility(EVisibility::HitTestInvisible)
 		.Margin(UUnicodeBrowserOptions::Get()->GridCellPadding)
 	];
@@ -99,7 +99,7 @@ FReply SUnicodeCharacterGridEntry::OnMouseButtonDoubleClick(FGeometry const& MyG
 	// the color and tooltip get reset by MouseEnter/MouseLeave 
 	SetBorderBackgroundColor(FLinearColor(0.35, 1.0, 0.35, 0.2));
 	SetToolTipText(FText::FromString(FString::Printf(TEXT("Character copied to clipboard"))));
-	FPlatformApplicationMisc::ClipboardCopy(*UnicodeCharacter->Character);
+	FPlatformApplicationMisc::ClipboardCopy(*UnicodeCharacter->GetCharacter());
 	return FReply::Handled();
 }
 
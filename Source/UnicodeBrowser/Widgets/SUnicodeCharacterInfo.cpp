@@ -1,6 +1,7 @@
 #include "SUnicodeCharacterInfo.h"
 
 #include "SlateOptMacros.h"
+
 #include "UnicodeBrowser/DataAsset_FontTags.h"
 #include "UnicodeBrowser/UnicodeBrowserOptions.h"
 
@@ -22,19 +23,19 @@ void SUnicodeCharacterInfo::Construct(FArguments const& InArgs)
 
 void SUnicodeCharacterInfo::SetRow(TSharedPtr<FUnicodeBrowserRow> InRow)
 {
-	if(!InRow.IsValid() || !InRow->bHasValidCharacter)
+	if(!InRow.IsValid() || !InRow->HasValidCharacter())
 		return;
 
 	FText TagsText = FText::GetEmpty();
 	
-	if(UUnicodeBrowserOptions::Get()->Preset && UUnicodeBrowserOptions::Get()->Preset->SupportsFont(*InRow->FontInfo))
+	if(UUnicodeBrowserOptions::Get()->Preset && UUnicodeBrowserOptions::Get()->Preset->SupportsFont(*InRow->GetFontInfo()))
 	{
-		TagsText = FText::FromString(TEXT("Tags: ") + FString::Join(UUnicodeBrowserOptions::Get()->Preset->GetCodepointTags(InRow->Codepoint), TEXT(", ")));			
+		TagsText = FText::FromString(TEXT("Tags: ") + FString::Join(UUnicodeBrowserOptions::Get()->Preset->GetCodepointTags(InRow->GetCodepoint()), TEXT(", ")));			
 	}
 
 	FString BlockRangeName = "";
-	if(InRow->BlockRange){
-		if(FUnicodeBlockRange const *Range = UnicodeBrowser::GetUnicodeBlockRanges().FindByPredicate([Needle = InRow->BlockRange.Get(EUnicodeBlockRange::ControlCharacter)](FUnicodeBlockRange const &Range){ return Range.Index == Needle; }))
+	if(InRow->GetBlockRange()){
+		if(FUnicodeBlockRange const *Range = UnicodeBrowser::GetUnicodeBlockRanges().FindByPredicate([Needle = InRow->GetBlockRange().Get(EUnicodeBlockRange::ControlCharacter)](FUnicodeBlockRange const &Range){ return Range.Index == Needle; }))
 		{
 			BlockRangeName = *Range->GetDisplayName().ToString();	
 		}
@@ -46,7 +47,14 @@ void SUnicodeCharacterInfo::SetRow(TSharedPtr<FUnicodeBrowserRow> InRow)
 			+SVerticalBox::Slot()
 			[
 				SNew(STextBlock)
-				.Text(FText::FromString(FString::Printf(TEXT("Codepoint: 0x%04X"), InRow->Codepoint)))
+				.Text(FText::FromString(FString::Printf(TEXT("Codepoint: 0x%04X"), InRow->GetCodepoint())))
+			]
+			// name
+			+SVerticalBox::Slot()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("Name: %s"), *UnicodeBrowser::GetUnicodeCharacterName(InRow->GetCodepoint()))))
+				.AutoWrapText(true)
 			]
 			// can load
 			+SVerticalBox::Slot()